@@ -0,0 +1,92 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/android++/CMakeLists.txt"
+  "/root/repo/android/CMakeLists.txt"
+  "/root/repo/android/android/os/CMakeLists.txt"
+  "/root/repo/android/android/util/CMakeLists.txt"
+  "/root/repo/android/java/lang/CMakeLists.txt"
+  "/root/repo/android/java/util/concurrent/CMakeLists.txt"
+  "/root/repo/benchmarks/CMakeLists.txt"
+  "/root/repo/benchmarks/os/CMakeLists.txt"
+  "/root/repo/cmake/HelperMacros.cmake"
+  "/root/repo/cmake/OptionsLinux.cmake"
+  "/root/repo/private/CMakeLists.txt"
+  "/root/repo/private/android++/CMakeLists.txt"
+  "/root/repo/private/android/os/CMakeLists.txt"
+  "/root/repo/private/java/io/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "android/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "android/android/os/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "android/android/util/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "android/java/lang/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "android/java/util/concurrent/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "android++/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "private/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "private/android/os/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "private/android++/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "private/java/io/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmarks/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmarks/os/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "android/android/os/CMakeFiles/android.os.dir/DependInfo.cmake"
+  "android/android/util/CMakeFiles/android.util.dir/DependInfo.cmake"
+  "android/java/lang/CMakeFiles/java.lang.dir/DependInfo.cmake"
+  "android/java/util/concurrent/CMakeFiles/java.util.concurrent.dir/DependInfo.cmake"
+  "android++/CMakeFiles/android++.c++.dir/DependInfo.cmake"
+  "private/android/os/CMakeFiles/private.android.os.dir/DependInfo.cmake"
+  "private/android++/CMakeFiles/android++.dir/DependInfo.cmake"
+  "private/java/io/CMakeFiles/private.java.io.dir/DependInfo.cmake"
+  "benchmarks/os/CMakeFiles/HandlerBenchmark.dir/DependInfo.cmake"
+  "benchmarks/os/CMakeFiles/HandlerBenchmarkSuite.dir/DependInfo.cmake"
+  "benchmarks/os/CMakeFiles/HandlerCheckSuite.dir/DependInfo.cmake"
+  "benchmarks/os/CMakeFiles/HandlerProducerBenchmark.dir/DependInfo.cmake"
+  "benchmarks/os/CMakeFiles/ParcelBenchmark.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/android++.c++.dir/Assertions.cpp.o"
+  "CMakeFiles/android++.c++.dir/Assertions.cpp.o.d"
+  "CMakeFiles/android++.c++.dir/LogHelper.cpp.o"
+  "CMakeFiles/android++.c++.dir/LogHelper.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/android++.c++.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
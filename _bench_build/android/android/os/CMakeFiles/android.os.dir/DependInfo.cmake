@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/android/android/os/Bundle.cpp" "android/android/os/CMakeFiles/android.os.dir/Bundle.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/Bundle.cpp.o.d"
+  "/root/repo/android/android/os/Coroutine.cpp" "android/android/os/CMakeFiles/android.os.dir/Coroutine.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/Coroutine.cpp.o.d"
+  "/root/repo/android/android/os/Debug.cpp" "android/android/os/CMakeFiles/android.os.dir/Debug.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/Debug.cpp.o.d"
+  "/root/repo/android/android/os/Handler.cpp" "android/android/os/CMakeFiles/android.os.dir/Handler.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/Handler.cpp.o.d"
+  "/root/repo/android/android/os/HandlerThread.cpp" "android/android/os/CMakeFiles/android.os.dir/HandlerThread.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/HandlerThread.cpp.o.d"
+  "/root/repo/android/android/os/Looper.cpp" "android/android/os/CMakeFiles/android.os.dir/Looper.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/Looper.cpp.o.d"
+  "/root/repo/android/android/os/Message.cpp" "android/android/os/CMakeFiles/android.os.dir/Message.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/Message.cpp.o.d"
+  "/root/repo/android/android/os/MessageQueue.cpp" "android/android/os/CMakeFiles/android.os.dir/MessageQueue.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/MessageQueue.cpp.o.d"
+  "/root/repo/android/android/os/Messenger.cpp" "android/android/os/CMakeFiles/android.os.dir/Messenger.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/Messenger.cpp.o.d"
+  "/root/repo/android/android/os/Parcel.cpp" "android/android/os/CMakeFiles/android.os.dir/Parcel.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/Parcel.cpp.o.d"
+  "/root/repo/android/android/os/ParcelFileDescriptor.cpp" "android/android/os/CMakeFiles/android.os.dir/ParcelFileDescriptor.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/ParcelFileDescriptor.cpp.o.d"
+  "/root/repo/android/android/os/Parcelable.cpp" "android/android/os/CMakeFiles/android.os.dir/Parcelable.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/Parcelable.cpp.o.d"
+  "/root/repo/android/android/os/StrictMode.cpp" "android/android/os/CMakeFiles/android.os.dir/StrictMode.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/StrictMode.cpp.o.d"
+  "/root/repo/android/android/os/SystemClock.cpp" "android/android/os/CMakeFiles/android.os.dir/SystemClock.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/SystemClock.cpp.o.d"
+  "/root/repo/android/android/os/linux/ProcessLinux.cpp" "android/android/os/CMakeFiles/android.os.dir/linux/ProcessLinux.cpp.o" "gcc" "android/android/os/CMakeFiles/android.os.dir/linux/ProcessLinux.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
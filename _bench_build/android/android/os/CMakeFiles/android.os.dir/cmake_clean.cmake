@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/android.os.dir/Bundle.cpp.o"
+  "CMakeFiles/android.os.dir/Bundle.cpp.o.d"
+  "CMakeFiles/android.os.dir/Coroutine.cpp.o"
+  "CMakeFiles/android.os.dir/Coroutine.cpp.o.d"
+  "CMakeFiles/android.os.dir/Debug.cpp.o"
+  "CMakeFiles/android.os.dir/Debug.cpp.o.d"
+  "CMakeFiles/android.os.dir/Handler.cpp.o"
+  "CMakeFiles/android.os.dir/Handler.cpp.o.d"
+  "CMakeFiles/android.os.dir/HandlerThread.cpp.o"
+  "CMakeFiles/android.os.dir/HandlerThread.cpp.o.d"
+  "CMakeFiles/android.os.dir/Looper.cpp.o"
+  "CMakeFiles/android.os.dir/Looper.cpp.o.d"
+  "CMakeFiles/android.os.dir/Message.cpp.o"
+  "CMakeFiles/android.os.dir/Message.cpp.o.d"
+  "CMakeFiles/android.os.dir/MessageQueue.cpp.o"
+  "CMakeFiles/android.os.dir/MessageQueue.cpp.o.d"
+  "CMakeFiles/android.os.dir/Messenger.cpp.o"
+  "CMakeFiles/android.os.dir/Messenger.cpp.o.d"
+  "CMakeFiles/android.os.dir/Parcel.cpp.o"
+  "CMakeFiles/android.os.dir/Parcel.cpp.o.d"
+  "CMakeFiles/android.os.dir/ParcelFileDescriptor.cpp.o"
+  "CMakeFiles/android.os.dir/ParcelFileDescriptor.cpp.o.d"
+  "CMakeFiles/android.os.dir/Parcelable.cpp.o"
+  "CMakeFiles/android.os.dir/Parcelable.cpp.o.d"
+  "CMakeFiles/android.os.dir/StrictMode.cpp.o"
+  "CMakeFiles/android.os.dir/StrictMode.cpp.o.d"
+  "CMakeFiles/android.os.dir/SystemClock.cpp.o"
+  "CMakeFiles/android.os.dir/SystemClock.cpp.o.d"
+  "CMakeFiles/android.os.dir/linux/ProcessLinux.cpp.o"
+  "CMakeFiles/android.os.dir/linux/ProcessLinux.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/android.os.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
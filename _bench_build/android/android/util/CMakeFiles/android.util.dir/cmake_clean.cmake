@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/android.util.dir/linux/LogLinux.cpp.o"
+  "CMakeFiles/android.util.dir/linux/LogLinux.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/android.util.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
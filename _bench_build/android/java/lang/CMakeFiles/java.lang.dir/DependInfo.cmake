@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/android/java/lang/Class.cpp" "android/java/lang/CMakeFiles/java.lang.dir/Class.cpp.o" "gcc" "android/java/lang/CMakeFiles/java.lang.dir/Class.cpp.o.d"
+  "/root/repo/android/java/lang/ClassLoader.cpp" "android/java/lang/CMakeFiles/java.lang.dir/ClassLoader.cpp.o" "gcc" "android/java/lang/CMakeFiles/java.lang.dir/ClassLoader.cpp.o.d"
+  "/root/repo/android/java/lang/Object.cpp" "android/java/lang/CMakeFiles/java.lang.dir/Object.cpp.o" "gcc" "android/java/lang/CMakeFiles/java.lang.dir/Object.cpp.o.d"
+  "/root/repo/android/java/lang/Package.cpp" "android/java/lang/CMakeFiles/java.lang.dir/Package.cpp.o" "gcc" "android/java/lang/CMakeFiles/java.lang.dir/Package.cpp.o.d"
+  "/root/repo/android/java/lang/linux/SystemLinux.cpp" "android/java/lang/CMakeFiles/java.lang.dir/linux/SystemLinux.cpp.o" "gcc" "android/java/lang/CMakeFiles/java.lang.dir/linux/SystemLinux.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/java.lang.dir/Class.cpp.o"
+  "CMakeFiles/java.lang.dir/Class.cpp.o.d"
+  "CMakeFiles/java.lang.dir/ClassLoader.cpp.o"
+  "CMakeFiles/java.lang.dir/ClassLoader.cpp.o.d"
+  "CMakeFiles/java.lang.dir/Object.cpp.o"
+  "CMakeFiles/java.lang.dir/Object.cpp.o.d"
+  "CMakeFiles/java.lang.dir/Package.cpp.o"
+  "CMakeFiles/java.lang.dir/Package.cpp.o.d"
+  "CMakeFiles/java.lang.dir/linux/SystemLinux.cpp.o"
+  "CMakeFiles/java.lang.dir/linux/SystemLinux.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/java.lang.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/java.util.concurrent.dir/ThreadPoolExecutor.cpp.o"
+  "CMakeFiles/java.util.concurrent.dir/ThreadPoolExecutor.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/java.util.concurrent.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
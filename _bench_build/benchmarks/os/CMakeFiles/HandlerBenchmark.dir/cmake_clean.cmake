@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/HandlerBenchmark"
+  "../../bin/HandlerBenchmark.pdb"
+  "CMakeFiles/HandlerBenchmark.dir/HandlerBenchmark.cpp.o"
+  "CMakeFiles/HandlerBenchmark.dir/HandlerBenchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/HandlerBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/HandlerBenchmarkSuite"
+  "../../bin/HandlerBenchmarkSuite.pdb"
+  "CMakeFiles/HandlerBenchmarkSuite.dir/HandlerBenchmarkSuite.cpp.o"
+  "CMakeFiles/HandlerBenchmarkSuite.dir/HandlerBenchmarkSuite.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/HandlerBenchmarkSuite.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
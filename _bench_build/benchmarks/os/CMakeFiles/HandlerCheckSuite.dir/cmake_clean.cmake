@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/HandlerCheckSuite"
+  "../../bin/HandlerCheckSuite.pdb"
+  "CMakeFiles/HandlerCheckSuite.dir/HandlerCheckSuite.cpp.o"
+  "CMakeFiles/HandlerCheckSuite.dir/HandlerCheckSuite.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/HandlerCheckSuite.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
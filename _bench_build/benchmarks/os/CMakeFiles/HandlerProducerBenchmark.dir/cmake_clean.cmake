@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/HandlerProducerBenchmark"
+  "../../bin/HandlerProducerBenchmark.pdb"
+  "CMakeFiles/HandlerProducerBenchmark.dir/HandlerProducerBenchmark.cpp.o"
+  "CMakeFiles/HandlerProducerBenchmark.dir/HandlerProducerBenchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/HandlerProducerBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
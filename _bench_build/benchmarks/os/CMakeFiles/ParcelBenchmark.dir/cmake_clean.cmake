@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/ParcelBenchmark"
+  "../../bin/ParcelBenchmark.pdb"
+  "CMakeFiles/ParcelBenchmark.dir/ParcelBenchmark.cpp.o"
+  "CMakeFiles/ParcelBenchmark.dir/ParcelBenchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ParcelBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
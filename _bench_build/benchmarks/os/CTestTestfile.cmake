@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/benchmarks/os
+# Build directory: /root/repo/_bench_build/benchmarks/os
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(HandlerCheckSuite "/root/repo/_bench_build/bin/HandlerCheckSuite")
+set_tests_properties(HandlerCheckSuite PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/benchmarks/os/CMakeLists.txt;47;add_test;/root/repo/benchmarks/os/CMakeLists.txt;0;")
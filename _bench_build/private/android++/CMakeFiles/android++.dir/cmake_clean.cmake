@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "../../lib/libandroid++.pdb"
+  "../../lib/libandroid++.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/android++.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,43 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/private/android/os/Binder.cpp" "private/android/os/CMakeFiles/private.android.os.dir/Binder.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/Binder.cpp.o.d"
+  "/root/repo/private/android/os/BinderProvider.cpp" "private/android/os/CMakeFiles/private.android.os.dir/BinderProvider.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/BinderProvider.cpp.o.d"
+  "/root/repo/private/android/os/BundlePrivate.cpp" "private/android/os/CMakeFiles/private.android.os.dir/BundlePrivate.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/BundlePrivate.cpp.o.d"
+  "/root/repo/private/android/os/HandlerProvider.cpp" "private/android/os/CMakeFiles/private.android.os.dir/HandlerProvider.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/HandlerProvider.cpp.o.d"
+  "/root/repo/private/android/os/LooperMetrics.cpp" "private/android/os/CMakeFiles/private.android.os.dir/LooperMetrics.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/LooperMetrics.cpp.o.d"
+  "/root/repo/private/android/os/MessagePool.cpp" "private/android/os/CMakeFiles/private.android.os.dir/MessagePool.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/MessagePool.cpp.o.d"
+  "/root/repo/private/android/os/MessageQueueProvider.cpp" "private/android/os/CMakeFiles/private.android.os.dir/MessageQueueProvider.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/MessageQueueProvider.cpp.o.d"
+  "/root/repo/private/android/os/MessageTarget.cpp" "private/android/os/CMakeFiles/private.android.os.dir/MessageTarget.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/MessageTarget.cpp.o.d"
+  "/root/repo/private/android/os/ParcelPrivate.cpp" "private/android/os/CMakeFiles/private.android.os.dir/ParcelPrivate.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/ParcelPrivate.cpp.o.d"
+  "/root/repo/private/android/os/ParcelablePrivate.cpp" "private/android/os/CMakeFiles/private.android.os.dir/ParcelablePrivate.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/ParcelablePrivate.cpp.o.d"
+  "/root/repo/private/android/os/PlatformHandle.cpp" "private/android/os/CMakeFiles/private.android.os.dir/PlatformHandle.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/PlatformHandle.cpp.o.d"
+  "/root/repo/private/android/os/SamplingProfiler.cpp" "private/android/os/CMakeFiles/private.android.os.dir/SamplingProfiler.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/SamplingProfiler.cpp.o.d"
+  "/root/repo/private/android/os/ServiceObject.cpp" "private/android/os/CMakeFiles/private.android.os.dir/ServiceObject.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/ServiceObject.cpp.o.d"
+  "/root/repo/private/android/os/Watchdog.cpp" "private/android/os/CMakeFiles/private.android.os.dir/Watchdog.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/Watchdog.cpp.o.d"
+  "/root/repo/private/android/os/WorkItemAllocator.cpp" "private/android/os/CMakeFiles/private.android.os.dir/WorkItemAllocator.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/WorkItemAllocator.cpp.o.d"
+  "/root/repo/private/android/os/WorkQueue.cpp" "private/android/os/CMakeFiles/private.android.os.dir/WorkQueue.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/WorkQueue.cpp.o.d"
+  "/root/repo/private/android/os/linux/BinderProviderLinux.cpp" "private/android/os/CMakeFiles/private.android.os.dir/linux/BinderProviderLinux.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/linux/BinderProviderLinux.cpp.o.d"
+  "/root/repo/private/android/os/linux/EventLoopLinux.cpp" "private/android/os/CMakeFiles/private.android.os.dir/linux/EventLoopLinux.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/linux/EventLoopLinux.cpp.o.d"
+  "/root/repo/private/android/os/linux/LooperLinux.cpp" "private/android/os/CMakeFiles/private.android.os.dir/linux/LooperLinux.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/linux/LooperLinux.cpp.o.d"
+  "/root/repo/private/android/os/linux/MessageQueueLinux.cpp" "private/android/os/CMakeFiles/private.android.os.dir/linux/MessageQueueLinux.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/linux/MessageQueueLinux.cpp.o.d"
+  "/root/repo/private/android/os/linux/PlatformFileDescriptorLinux.cpp" "private/android/os/CMakeFiles/private.android.os.dir/linux/PlatformFileDescriptorLinux.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/linux/PlatformFileDescriptorLinux.cpp.o.d"
+  "/root/repo/private/android/os/linux/PlatformHandleLinux.cpp" "private/android/os/CMakeFiles/private.android.os.dir/linux/PlatformHandleLinux.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/linux/PlatformHandleLinux.cpp.o.d"
+  "/root/repo/private/android/os/linux/SamplingProfilerLinux.cpp" "private/android/os/CMakeFiles/private.android.os.dir/linux/SamplingProfilerLinux.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/linux/SamplingProfilerLinux.cpp.o.d"
+  "/root/repo/private/android/os/linux/StrictModeLinux.cpp" "private/android/os/CMakeFiles/private.android.os.dir/linux/StrictModeLinux.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/linux/StrictModeLinux.cpp.o.d"
+  "/root/repo/private/android/os/linux/WatchdogLinux.cpp" "private/android/os/CMakeFiles/private.android.os.dir/linux/WatchdogLinux.cpp.o" "gcc" "private/android/os/CMakeFiles/private.android.os.dir/linux/WatchdogLinux.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
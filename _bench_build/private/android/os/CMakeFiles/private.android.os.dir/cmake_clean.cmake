@@ -0,0 +1,57 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/private.android.os.dir/Binder.cpp.o"
+  "CMakeFiles/private.android.os.dir/Binder.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/BinderProvider.cpp.o"
+  "CMakeFiles/private.android.os.dir/BinderProvider.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/BundlePrivate.cpp.o"
+  "CMakeFiles/private.android.os.dir/BundlePrivate.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/HandlerProvider.cpp.o"
+  "CMakeFiles/private.android.os.dir/HandlerProvider.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/LooperMetrics.cpp.o"
+  "CMakeFiles/private.android.os.dir/LooperMetrics.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/MessagePool.cpp.o"
+  "CMakeFiles/private.android.os.dir/MessagePool.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/MessageQueueProvider.cpp.o"
+  "CMakeFiles/private.android.os.dir/MessageQueueProvider.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/MessageTarget.cpp.o"
+  "CMakeFiles/private.android.os.dir/MessageTarget.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/ParcelPrivate.cpp.o"
+  "CMakeFiles/private.android.os.dir/ParcelPrivate.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/ParcelablePrivate.cpp.o"
+  "CMakeFiles/private.android.os.dir/ParcelablePrivate.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/PlatformHandle.cpp.o"
+  "CMakeFiles/private.android.os.dir/PlatformHandle.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/SamplingProfiler.cpp.o"
+  "CMakeFiles/private.android.os.dir/SamplingProfiler.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/ServiceObject.cpp.o"
+  "CMakeFiles/private.android.os.dir/ServiceObject.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/Watchdog.cpp.o"
+  "CMakeFiles/private.android.os.dir/Watchdog.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/WorkItemAllocator.cpp.o"
+  "CMakeFiles/private.android.os.dir/WorkItemAllocator.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/WorkQueue.cpp.o"
+  "CMakeFiles/private.android.os.dir/WorkQueue.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/linux/BinderProviderLinux.cpp.o"
+  "CMakeFiles/private.android.os.dir/linux/BinderProviderLinux.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/linux/EventLoopLinux.cpp.o"
+  "CMakeFiles/private.android.os.dir/linux/EventLoopLinux.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/linux/LooperLinux.cpp.o"
+  "CMakeFiles/private.android.os.dir/linux/LooperLinux.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/linux/MessageQueueLinux.cpp.o"
+  "CMakeFiles/private.android.os.dir/linux/MessageQueueLinux.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/linux/PlatformFileDescriptorLinux.cpp.o"
+  "CMakeFiles/private.android.os.dir/linux/PlatformFileDescriptorLinux.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/linux/PlatformHandleLinux.cpp.o"
+  "CMakeFiles/private.android.os.dir/linux/PlatformHandleLinux.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/linux/SamplingProfilerLinux.cpp.o"
+  "CMakeFiles/private.android.os.dir/linux/SamplingProfilerLinux.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/linux/StrictModeLinux.cpp.o"
+  "CMakeFiles/private.android.os.dir/linux/StrictModeLinux.cpp.o.d"
+  "CMakeFiles/private.android.os.dir/linux/WatchdogLinux.cpp.o"
+  "CMakeFiles/private.android.os.dir/linux/WatchdogLinux.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/private.android.os.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
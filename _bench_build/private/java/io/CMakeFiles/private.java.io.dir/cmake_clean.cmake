@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/private.java.io.dir/ByteReader.cpp.o"
+  "CMakeFiles/private.java.io.dir/ByteReader.cpp.o.d"
+  "CMakeFiles/private.java.io.dir/ByteWriter.cpp.o"
+  "CMakeFiles/private.java.io.dir/ByteWriter.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/private.java.io.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -36,7 +36,7 @@ ANDROID_C_EXPORT int LOG_ASSERT(const char* file, unsigned line);
 
 #ifndef assert
 #ifdef NDEBUG
-#define assert ((void)0)
+#define assert(expression) ((void)0)
 #else
 #define assert assert_wtf
 #endif
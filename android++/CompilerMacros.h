@@ -55,6 +55,14 @@
 #error "Please use a newer version of Visual Studio. WebKit requires VS2013 or newer to compile."
 #endif
 
+/* COMPILER_SUPPORTS_CXX_COROUTINES - C++20 coroutines, with the <coroutine> header */
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define COMPILER_SUPPORTS_CXX_COROUTINES 1
+#endif
+#endif
+
 /* FALLTHROUGH */
 
 #if !defined(FALLTHROUGH) && COMPILER_SUPPORTS(FALLTHROUGH_WARNINGS) && COMPILER(CLANG)
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace android {
+
+template<typename, std::size_t = 56>
+class inline_function;
+
+// A move-only std::function which keeps callables of up to Capacity bytes inside itself instead of on the heap.
+// Larger or throwing-move callables still work, they are just allocated.
+template<typename R, typename... P, std::size_t Capacity>
+class inline_function<R (P...), Capacity> {
+public:
+    inline_function() = default;
+    inline_function(std::nullptr_t) { }
+    template<typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, inline_function>::value>::type>
+    inline_function(F&& function)
+    {
+        typedef typename std::decay<F>::type Function;
+        construct<Function>(std::forward<F>(function), std::integral_constant<bool, fitsInline<Function>()>());
+    }
+    inline_function(inline_function&& other)
+    {
+        moveFrom(other);
+    }
+    inline_function(const inline_function&) = delete;
+    ~inline_function()
+    {
+        reset();
+    }
+
+    inline_function& operator=(inline_function&& other)
+    {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+    inline_function& operator=(const inline_function&) = delete;
+
+    explicit operator bool() const
+    {
+        return !!m_operations;
+    }
+
+    R operator()(P... arguments) const
+    {
+        return m_operations->invoke(const_cast<unsigned char*>(m_storage), std::forward<P>(arguments)...);
+    }
+
+    // Returns the type of the stored callable, or typeid(void) if there is none.
+    const std::type_info& target_type() const
+    {
+        return m_operations ? *m_operations->type : typeid(void);
+    }
+
+    // Returns a pointer to the stored callable if it is of type T, or null otherwise.
+    template<typename T> T* target()
+    {
+        if (m_operations == &inlineOperations<T>)
+            return reinterpret_cast<T*>(m_storage);
+        if (m_operations == &heapOperations<T>)
+            return *reinterpret_cast<T**>(m_storage);
+        return nullptr;
+    }
+    template<typename T> const T* target() const
+    {
+        return const_cast<inline_function*>(this)->template target<T>();
+    }
+
+private:
+    struct Operations {
+        const std::type_info* type;
+        R (*invoke)(void*, P&&...);
+        void (*move)(void* from, void* to);
+        void (*destroy)(void*);
+    };
+
+    template<typename F> static constexpr bool fitsInline()
+    {
+        return sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<F>::value;
+    }
+
+    template<typename Function, typename F> void construct(F&& function, std::true_type)
+    {
+        new (m_storage) Function(std::forward<F>(function));
+        m_operations = &inlineOperations<Function>;
+    }
+    template<typename Function, typename F> void construct(F&& function, std::false_type)
+    {
+        *reinterpret_cast<Function**>(m_storage) = new Function(std::forward<F>(function));
+        m_operations = &heapOperations<Function>;
+    }
+
+    template<typename F> static R invokeInline(void* storage, P&&... arguments)
+    {
+        return (*static_cast<F*>(storage))(std::forward<P>(arguments)...);
+    }
+    template<typename F> static void moveInline(void* from, void* to)
+    {
+        new (to) F(std::move(*static_cast<F*>(from)));
+        static_cast<F*>(from)->~F();
+    }
+    template<typename F> static void destroyInline(void* storage)
+    {
+        static_cast<F*>(storage)->~F();
+    }
+
+    template<typename F> static R invokeHeap(void* storage, P&&... arguments)
+    {
+        return (**static_cast<F**>(storage))(std::forward<P>(arguments)...);
+    }
+    template<typename F> static void moveHeap(void* from, void* to)
+    {
+        *static_cast<F**>(to) = *static_cast<F**>(from);
+    }
+    template<typename F> static void destroyHeap(void* storage)
+    {
+        delete *static_cast<F**>(storage);
+    }
+
+    template<typename F> static const Operations inlineOperations;
+    template<typename F> static const Operations heapOperations;
+
+    void moveFrom(inline_function& other)
+    {
+        m_operations = other.m_operations;
+        if (m_operations)
+            m_operations->move(other.m_storage, m_storage);
+        other.m_operations = nullptr;
+    }
+
+    void reset()
+    {
+        if (m_operations)
+            m_operations->destroy(m_storage);
+        m_operations = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[Capacity];
+    const Operations* m_operations { nullptr };
+};
+
+template<typename R, typename... P, std::size_t Capacity>
+template<typename F>
+const typename inline_function<R (P...), Capacity>::Operations inline_function<R (P...), Capacity>::inlineOperations = {
+    &typeid(F), &inline_function::invokeInline<F>, &inline_function::moveInline<F>, &inline_function::destroyInline<F>
+};
+
+template<typename R, typename... P, std::size_t Capacity>
+template<typename F>
+const typename inline_function<R (P...), Capacity>::Operations inline_function<R (P...), Capacity>::heapOperations = {
+    &typeid(F), &inline_function::invokeHeap<F>, &inline_function::moveHeap<F>, &inline_function::destroyHeap<F>
+};
+
+} // namespace android
+
+using android::inline_function;
@@ -64,11 +64,9 @@ public:
 
     void construct()
     {
-#if !defined(NDEBUG)
         assert(!m_isConstructed);
 
         m_isConstructed = true;
-#endif
         m_constructor(asPtr());
     }
 
@@ -92,11 +90,9 @@ private:
 
     std::function<void (void*)> m_constructor;
 
-#if !defined(NDEBUG)
     // LazyNeverDestroyed objects are always static, so this variable is initialized to false.
     // It must not be initialized dynamically, because that would not be thread safe.
     bool m_isConstructed;
-#endif
 };
 
 } // namespace WTF
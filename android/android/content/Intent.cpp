@@ -125,7 +125,7 @@ int32_t Intent::getIntExtra(StringRef name, int32_t defaultValue)
 
 Intent& Intent::putExtra(StringRef name, int32_t value)
 {
-    os::BundlePrivate::getPrivate(m_private->m_extras).putValue(name, os::BundleValue(value));
+    os::BundlePrivate::getMutablePrivate(m_private->m_extras).putValue(name, os::BundleValue(value));
     return *this;
 }
 
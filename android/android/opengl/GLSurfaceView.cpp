@@ -27,6 +27,7 @@
 
 #include <android/app/ActivityHostWindow.h>
 #include <android/opengl/GLES2/esUtil.h>
+#include <android/view/Choreographer.h>
 #include <android/view/ViewPrivate.h>
 #include <android++/CompilerMacros.h>
 #include <android++/LogHelper.h>
@@ -118,7 +119,9 @@ private:
     GLSurfaceView& m_view;
 };
 
-class GLSurfaceView::GLThread {
+// In RENDERMODE_CONTINUOUSLY, frames are requested from the choreographer of the view's thread, so the renderer
+// draws once per vsync instead of as fast as the GL thread can spin.
+class GLSurfaceView::GLThread : public view::Choreographer::FrameCallback {
 public:
     GLThread(GLSurfaceView& v)
         : m_view(v)
@@ -159,6 +162,7 @@ public:
             m_renderMode = renderMode;
             sGLThreadManager.notifyAll();
         }
+        updateFrameCallback();
     }
 
     void surfaceCreated()
@@ -254,6 +258,7 @@ public:
 
     void requestExit()
     {
+        stopFrameCallback();
         requestExitAndWait();
         m_thread->join();
     }
@@ -271,11 +276,22 @@ public:
             else
                restartPaint();
         });
+        m_choreographer = &view::Choreographer::getInstance();
+        updateFrameCallback();
     }
 
     void onDetachedFromWindow()
     {
         view::getPrivate(m_view).hostWindow()->setOnWindowPositionChangeListener(nullptr);
+        stopFrameCallback();
+    }
+
+    // view::Choreographer::FrameCallback
+    void doFrame(std::chrono::nanoseconds) override
+    {
+        m_frameCallbackPosted = false;
+        requestRender();
+        updateFrameCallback();
     }
 
     void suspendPaint()
@@ -304,6 +320,35 @@ public:
     }
 
 private:
+    // Keeps a frame callback posted while rendering continuously on an attached view. Called on the view's thread.
+    void updateFrameCallback()
+    {
+        if (!m_choreographer)
+            return;
+
+        bool continuously;
+        synchronized (sGLThreadManager) {
+            continuously = m_renderMode == RENDERMODE_CONTINUOUSLY;
+        }
+
+        if (continuously == m_frameCallbackPosted)
+            return;
+
+        if (continuously)
+            m_choreographer->postFrameCallback(this);
+        else
+            m_choreographer->removeFrameCallback(this);
+        m_frameCallbackPosted = continuously;
+    }
+
+    void stopFrameCallback()
+    {
+        if (m_choreographer && m_frameCallbackPosted)
+            m_choreographer->removeFrameCallback(this);
+        m_frameCallbackPosted = false;
+        m_choreographer = nullptr;
+    }
+
     void threadLoop() 
     {
         guardedRun();
@@ -333,7 +378,7 @@ private:
 
     bool readyToDraw()
     {
-        return !m_paused && m_hasSurface && !m_surfaceIsBad && (m_requestRender || (m_renderMode == RENDERMODE_CONTINUOUSLY));
+        return !m_paused && m_hasSurface && !m_surfaceIsBad && m_requestRender;
     }
 
     bool testEGLContextLost()
@@ -558,6 +603,8 @@ private:
     bool m_requestRender;
     bool m_renderComplete;
     std::deque<std::function<void ()>> m_eventQueue;
+    view::Choreographer* m_choreographer { nullptr };
+    bool m_frameCallbackPosted { false };
 
     GLSurfaceView& m_view;
     EGLHelper m_eglHelper;
@@ -138,32 +138,32 @@ int16_t Bundle::getShort(StringRef key, short defaultValue)
 
 void Bundle::putByte(StringRef key, int8_t value)
 {
-    m_private->putValue(key, BundleValue(value));
+    mutablePrivate().putValue(key, BundleValue(value));
 }
 
 void Bundle::putChar(StringRef key, wchar_t value)
 {
-    m_private->putValue(key, BundleValue(value));
+    mutablePrivate().putValue(key, BundleValue(value));
 }
 
 void Bundle::putCharSequence(StringRef key, const CharSequence& value)
 {
-    m_private->putCharSequence(key, value);
+    mutablePrivate().putCharSequence(key, value);
 }
 
 void Bundle::putFloat(StringRef key, float value)
 {
-    m_private->putValue(key, BundleValue(value));
+    mutablePrivate().putValue(key, BundleValue(value));
 }
 
 void Bundle::putInt(StringRef key, int32_t value)
 {
-    m_private->putValue(key, BundleValue(value));
+    mutablePrivate().putValue(key, BundleValue(value));
 }
 
 void Bundle::putShort(StringRef key, int16_t value)
 {
-    m_private->putValue(key, BundleValue(value));
+    mutablePrivate().putValue(key, BundleValue(value));
 }
 
 std::shared_ptr<Parcelable> Bundle::getParcelable(StringRef key)
@@ -173,22 +173,22 @@ std::shared_ptr<Parcelable> Bundle::getParcelable(StringRef key)
 
 void Bundle::putParcelable(StringRef key, std::passed_ptr<Parcelable> value)
 {
-    m_private->putParcelable(key, value);
+    mutablePrivate().putParcelable(key, value);
 }
 
 void Bundle::readFromParcel(Parcel& parcel)
 {
-    m_private->readFromParcel(parcel);
+    mutablePrivate().readFromParcel(parcel);
 }
 
 void Bundle::clear()
 {
-    m_private->clear();
+    mutablePrivate().clear();
 }
 
 void Bundle::remove(StringRef key)
 {
-    m_private->remove(key);
+    mutablePrivate().remove(key);
 }
 
 bool Bundle::containsKey(StringRef key)
@@ -196,6 +196,14 @@ bool Bundle::containsKey(StringRef key)
     return m_private->findKey(key);
 }
 
+BundlePrivate& Bundle::mutablePrivate()
+{
+    if (m_private.use_count() > 1)
+        m_private = std::make_shared<BundlePrivate>(*m_private);
+
+    return *m_private;
+}
+
 class BundleCreator final : public ParcelableCreator {
 public:
     std::shared_ptr<Parcelable> createFromParcel(Parcel& source) override
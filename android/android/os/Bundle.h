@@ -105,6 +105,9 @@ public:
     ANDROID_EXPORT virtual void writeToParcel(Parcel& dest, int32_t flags) const override;
 
 private:
+    // Copies of a Bundle share their storage until one of them is modified.
+    BundlePrivate& mutablePrivate();
+
     std::shared_ptr<BundlePrivate> m_private;
 };
 
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Coroutine.h"
+
+#include <android/os/WorkItemAllocator.h>
+
+#include <new>
+
+namespace android {
+namespace os {
+
+namespace {
+
+struct FrameHeader {
+    std::shared_ptr<MessageQueue> queue;
+};
+
+}
+
+static const size_t frameHeaderSize = (sizeof(FrameHeader) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+void* CoroutineFrame::allocate(size_t size)
+{
+    Looper* looper = Looper::myLooper();
+    std::shared_ptr<MessageQueue> queue = looper ? looper->m_queue : nullptr;
+
+    void* memory = queue ? queue->m_allocator->allocate(frameHeaderSize + size) : ::operator new(frameHeaderSize + size);
+    new (memory) FrameHeader { std::move(queue) };
+    return static_cast<unsigned char*>(memory) + frameHeaderSize;
+}
+
+void CoroutineFrame::deallocate(void* frame)
+{
+    if (!frame)
+        return;
+
+    FrameHeader* header = reinterpret_cast<FrameHeader*>(static_cast<unsigned char*>(frame) - frameHeaderSize);
+    // The queue may go away with the last frame referencing it, so it must outlive the release of the block.
+    std::shared_ptr<MessageQueue> queue = std::move(header->queue);
+    header->~FrameHeader();
+
+    if (queue)
+        WorkItemAllocator::deallocate(header);
+    else
+        ::operator delete(header);
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <android/os/Handler.h>
+#include <android/os/Looper.h>
+
+namespace android {
+namespace os {
+
+// Allocates coroutine frames from the work item slab of the calling thread's looper, or from the heap on threads
+// without one. A frame keeps the queue owning its slab alive until it is released.
+class CoroutineFrame final {
+public:
+    ANDROID_EXPORT static void* allocate(size_t size);
+    ANDROID_EXPORT static void deallocate(void* frame);
+
+private:
+    CoroutineFrame() = delete;
+};
+
+} // namespace os
+} // namespace android
+
+#if COMPILER_SUPPORTS(CXX_COROUTINES)
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+
+namespace android {
+namespace os {
+
+// Suspends the awaiting coroutine and resumes it on the thread of a handler, after an optional delay. The
+// resumption is posted as an ordinary runnable which stores the coroutine handle inline, so a suspended coroutine
+// is a single queue entry. co_await yields false if the handler's looper is quitting, in which case the coroutine
+// carries on in the calling thread.
+class HandlerAwaiter final {
+public:
+    HandlerAwaiter(Handler& handler, std::chrono::nanoseconds delay)
+        : m_handler(handler)
+        , m_delay(delay)
+    {
+    }
+
+    bool await_ready() const
+    {
+        return m_delay <= std::chrono::nanoseconds::zero() && m_handler.getLooper() == Looper::myLooper();
+    }
+
+    bool await_suspend(std::coroutine_handle<> continuation)
+    {
+        // Once posted, the coroutine may be resumed on the other thread before this returns, so the awaiter must
+        // not be touched anymore.
+        m_resumed = true;
+        if (m_handler.postDelayed([continuation] { continuation.resume(); }, m_delay))
+            return true;
+
+        m_resumed = false;
+        return false;
+    }
+
+    bool await_resume() const { return m_resumed; }
+
+private:
+    Handler& m_handler;
+    std::chrono::nanoseconds m_delay;
+    bool m_resumed { true };
+};
+
+inline HandlerAwaiter Handler::resumeOn()
+{
+    return HandlerAwaiter(*this, std::chrono::nanoseconds::zero());
+}
+
+// Resumes the awaiting coroutine on the thread of handler once delay has elapsed.
+template<typename Rep, typename Period>
+inline HandlerAwaiter delay(Handler& handler, std::chrono::duration<Rep, Period> delay)
+{
+    return HandlerAwaiter(handler, std::chrono::duration_cast<std::chrono::nanoseconds>(delay));
+}
+
+template<typename T> class Task;
+
+namespace detail {
+
+class TaskPromiseBase {
+public:
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) noexcept
+        {
+            TaskPromiseBase& promise = finished.promise();
+            if (promise.m_continuation)
+                return promise.m_continuation;
+
+            // Nobody is waiting for a detached task, so it releases itself.
+            if (promise.m_detached)
+                finished.destroy();
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept { }
+    };
+
+    static void* operator new(size_t size) { return CoroutineFrame::allocate(size); }
+    static void operator delete(void* frame) { CoroutineFrame::deallocate(frame); }
+
+    std::suspend_always initial_suspend() noexcept { return { }; }
+    FinalAwaiter final_suspend() noexcept { return { }; }
+    // Exceptions are not used in this codebase.
+    void unhandled_exception() { std::terminate(); }
+
+    void setContinuation(std::coroutine_handle<> continuation) { m_continuation = continuation; }
+    void setDetached() { m_detached = true; }
+
+private:
+    std::coroutine_handle<> m_continuation;
+    bool m_detached { false };
+};
+
+template<typename T>
+class TaskPromise final : public TaskPromiseBase {
+public:
+    Task<T> get_return_object();
+
+    template<typename U> void return_value(U&& value) { m_value.emplace(std::forward<U>(value)); }
+    T result() { return std::move(*m_value); }
+
+private:
+    std::optional<T> m_value;
+};
+
+template<>
+class TaskPromise<void> final : public TaskPromiseBase {
+public:
+    Task<void> get_return_object();
+
+    void return_void() { }
+    void result() { }
+};
+
+} // namespace detail
+
+// A lazily started coroutine producing a T. Awaiting a task starts it, and resumes the awaiter with its result when
+// it finishes, on whichever thread it finished. A task which nobody awaits is started with start().
+template<typename T = void>
+class Task final {
+    NONCOPYABLE(Task);
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task(Task&& other) : m_handle(std::exchange(other.m_handle, nullptr)) { }
+    ~Task()
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    bool await_ready() const { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation)
+    {
+        m_handle.promise().setContinuation(continuation);
+        return m_handle;
+    }
+    T await_resume() { return m_handle.promise().result(); }
+
+    // Runs the task without awaiting it. The frame is released when the coroutine finishes; a coroutine left
+    // suspended on a looper which quits is never resumed, nor released.
+    void start() &&
+    {
+        std::coroutine_handle<promise_type> handle = std::exchange(m_handle, nullptr);
+        handle.promise().setDetached();
+        handle.resume();
+    }
+
+private:
+    friend promise_type;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : m_handle(handle) { }
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+namespace detail {
+
+template<typename T>
+inline Task<T> TaskPromise<T>::get_return_object()
+{
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object()
+{
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+} // namespace os
+} // namespace android
+
+template<typename T = void> using Task = android::os::Task<T>;
+
+#endif
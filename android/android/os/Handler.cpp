@@ -27,48 +27,42 @@
 
 #include "Looper.h"
 #include "Message.h"
+#include "MessageQueue.h"
 #include <android/os/HandlerProvider.h>
-#include <java/lang/System.h>
+#include <android/os/SystemClock.h>
+#include <android/os/WorkItem.h>
 
-#include <algorithm>
-#include <mutex>
 #include <android++/LogHelper.h>
+#include <typeinfo>
 
 namespace android {
 namespace os {
 
-class WorkItem {
-public:
-    WorkItem(Handler& h, std::chrono::milliseconds fireTime)
-        : m_owner(h)
-        , m_fireTime(fireTime)
-    {
-    }
-    virtual ~WorkItem()
-    {
-    }
-
-    virtual void performWork() = 0;
-
-    virtual bool isMessageOf(int32_t what) = 0;
-    virtual bool isMessageOf(std::function<void ()>& r) = 0;
+static const std::type_info& targetTypeOf(const Handler::runnable_t& r)
+{
+    if (const std::function<void ()>* function = r.target<std::function<void ()>>())
+        return function->target_type();
+    return r.target_type();
+}
 
-    virtual std::chrono::milliseconds fireTime()
-    {
-        return m_fireTime;
-    }
+static const void* objectOf(Message& msg)
+{
+    return msg.obj ? (*msg.obj).get() : nullptr;
+}
 
-protected:
-    Handler& m_owner;
-    std::chrono::milliseconds m_fireTime;
-};
+static Handler::Priority priorityOf(Handler& h, Message& msg)
+{
+    return (msg.getPriority() == Handler::PRIORITY_DEFAULT) ? h.getPriority() : msg.getPriority();
+}
 
 class MessageWorkItem : public WorkItem {
 public:
-    MessageWorkItem(Handler& h, std::chrono::milliseconds fireTime, Message& msg)
-        : WorkItem(h, fireTime)
-        , m_message(msg)
+    MessageWorkItem(Handler& h, std::chrono::nanoseconds fireTime, Message&& msg, bool asynchronous)
+        : WorkItem(h, fireTime, true, msg.what, objectOf(msg), asynchronous || msg.isAsynchronous(), priorityOf(h, msg))
+        , m_message(std::move(msg))
     {
+        m_message.target = &h;
+        m_message.setAsynchronous(m_asynchronous);
     }
     ~MessageWorkItem()
     {
@@ -76,17 +70,7 @@ public:
 
     void performWork()
     {
-        m_owner.handleMessage(m_message);
-        delete this;
-    }
-
-    bool isMessageOf(int32_t what)
-    {
-        return what == m_message.what;
-    }
-    bool isMessageOf(std::function<void ()>& r)
-    {
-        return false;
+        m_message.target->dispatchMessage(m_message);
     }
 
 private:
@@ -95,8 +79,8 @@ private:
 
 class RunnableWorkItem : public WorkItem {
 public:
-    RunnableWorkItem(Handler& h, std::chrono::milliseconds fireTime, std::function<void ()>&& r)
-        : WorkItem(h, fireTime)
+    RunnableWorkItem(Handler& h, std::chrono::nanoseconds fireTime, Handler::runnable_t&& r, intptr_t identity, const void* token, bool asynchronous)
+        : WorkItem(h, fireTime, false, identity, token, asynchronous, h.getPriority())
         , m_runnable(std::move(r))
     {
     }
@@ -107,41 +91,54 @@ public:
     void performWork()
     {
         m_runnable();
-        delete this;
     }
 
-    bool isMessageOf(int32_t what)
-    {
-        return false;
-    }
-    bool isMessageOf(std::function<void ()>& r)
+    const std::type_info* callableType() const override
     {
-        return m_runnable.target<void(*)()>() == r.target<void(*)()>();
+        return &targetTypeOf(m_runnable);
     }
 
 private:
-    std::function<void ()> m_runnable;
+    Handler::runnable_t m_runnable;
 };
 
-static void enqueueWorkItem(std::vector<std::unique_ptr<WorkItem>>& workQueue, std::unique_ptr<WorkItem>&& item)
+static_assert(sizeof(MessageWorkItem) <= WorkItemAllocator::MAX_OBJECT_SIZE, "MessageWorkItem must fit into a slab block");
+static_assert(sizeof(RunnableWorkItem) <= WorkItemAllocator::MAX_OBJECT_SIZE, "RunnableWorkItem must fit into a slab block");
+
+Handler::Handler()
+    : Handler(Looper::myLooper())
 {
-    workQueue.push_back(std::move(item));
-    std::stable_sort(workQueue.begin(), workQueue.end(), [=] (const std::unique_ptr<WorkItem>& lhs, const std::unique_ptr<WorkItem>& rhs) {
-        return lhs->fireTime() < rhs->fireTime();
-    });
 }
 
-static const std::chrono::milliseconds oneMillisecond = std::chrono::duration<int32_t, std::milli>(1);
+Handler::Handler(Looper* looper)
+    : Handler(looper, false)
+{
+}
 
-Handler::Handler()
-    : m_handler(std::make_unique<HandlerProvider>(*this))
-    , m_nextFireTime(std::chrono::milliseconds::max())
-    , m_looper(Looper::myLooper())
+Handler::Handler(Looper* looper, bool async)
+    : Handler(looper, async, PRIORITY_NORMAL)
 {
 }
 
+Handler::Handler(Looper* looper, bool async, Priority priority)
+    : m_looper(looper)
+    , m_asynchronous(async)
+    , m_priority(priority)
+{
+    assert(priority > PRIORITY_DEFAULT && priority < PRIORITY_COUNT);
+    if (!m_looper) {
+        // A handler used to bring its own event source with it, so creating one on a thread which has not
+        // been prepared yet (e.g. before prepareMainLooper()) still has to work.
+        Looper::prepare();
+        m_looper = Looper::myLooper();
+    }
+
+    m_queue = m_looper->m_queue;
+}
+
 Handler::~Handler()
 {
+    m_queue->removeWorkItems(WorkItem::OWNER_INDEX, { this, 0, false });
 }
 
 Looper* Handler::getLooper()
@@ -149,18 +146,33 @@ Looper* Handler::getLooper()
     return m_looper;
 }
 
+Handler::Priority Handler::getPriority() const
+{
+    return m_priority;
+}
+
+void Handler::dispatchMessage(Message& msg)
+{
+    handleMessage(msg);
+}
+
 void Handler::handleMessage(Message& msg)
 {
 }
 
 bool Handler::hasMessages(int32_t what)
 {
-    synchronized (this) {
-        for (auto& workItem : m_workQueue)
-            if (workItem->isMessageOf(what))
-                return true;
-    }
-    return false;
+    return m_queue->hasWorkItems(WorkItem::MATCH_INDEX, { this, what, true });
+}
+
+bool Handler::hasMessages(int32_t what, const void* object)
+{
+    if (!object)
+        return hasMessages(what);
+
+    return m_queue->hasWorkItems(WorkItem::MATCH_INDEX, { this, what, true }, [=] (WorkItem& workItem) {
+        return workItem.token() == object;
+    });
 }
 
 Message Handler::obtainMessage()
@@ -178,172 +190,203 @@ Message Handler::obtainMessage(int32_t what, int32_t arg1, int32_t arg2)
     return Message::obtain(this, what, arg1, arg2);
 }
 
-void Handler::removeCallbacks(std::function<void ()>&& r)
+void Handler::removeCallbacksWithIdentity(intptr_t identity, const void* token)
+{
+    if (!identity)
+        return;
+
+    m_queue->removeWorkItems(WorkItem::MATCH_INDEX, { this, identity, false }, [=] (WorkItem& workItem) {
+        return !token || workItem.token() == token;
+    });
+}
+
+void Handler::removeCallbacksAndMessages(const void* token)
 {
-    removeWorkItems(std::move(r));
+    if (!token)
+        m_queue->removeWorkItems(WorkItem::OWNER_INDEX, { this, 0, false });
+    else
+        m_queue->removeWorkItems(WorkItem::TOKEN_INDEX, { this, reinterpret_cast<intptr_t>(token), false });
 }
 
 bool Handler::post(std::function<void ()>&& r)
 {
-    synchronized (this) {
-        enqueueWorkItem(m_workQueue, std::make_unique<RunnableWorkItem>(*this, System::currentTimeMillis(), std::move(r)));
-        return start();
-    }
+    return post(runnable_t(std::move(r)));
 }
 
-bool Handler::postAtFrontOfQueue(std::function<void ()>&& r)
+bool Handler::post(runnable_t&& r)
 {
-    synchronized (this) {
-        enqueueWorkItem(m_workQueue, std::make_unique<RunnableWorkItem>(*this, System::currentTimeMillis() - oneMillisecond, std::move(r)));
-        return start();
-    }
+    intptr_t identity = functionIdentity(r);
+    return postCallbackDelayed(std::move(r), identity, nullptr, std::chrono::nanoseconds::zero());
 }
 
-bool Handler::postAtTime(std::function<void ()>&& r, std::chrono::milliseconds uptimeMillis)
+bool Handler::postAtFrontOfQueue(std::function<void ()>&& r)
 {
-    synchronized (this) {
-        enqueueWorkItem(m_workQueue, std::make_unique<RunnableWorkItem>(*this, uptimeMillis, std::move(r)));
-        return startAtTime();
-    }
+    return postAtFrontOfQueue(runnable_t(std::move(r)));
 }
 
-bool Handler::postDelayed(std::function<void ()>&& r, std::chrono::milliseconds delayMillis)
+bool Handler::postAtFrontOfQueue(runnable_t&& r)
 {
-    return postAtTime(std::move(r), System::currentTimeMillis() + delayMillis);
+    intptr_t identity = functionIdentity(r);
+    return postCallbackAtFrontOfQueue(std::move(r), identity);
 }
 
-void Handler::removeMessages(int32_t what)
+bool Handler::postAtTime(std::function<void ()>&& r, std::chrono::milliseconds uptimeMillis)
 {
-    removeWorkItems(what);
+    return postAtTime(runnable_t(std::move(r)), std::chrono::nanoseconds(uptimeMillis));
 }
 
-bool Handler::sendEmptyMessage(int32_t what)
+bool Handler::postAtTime(runnable_t&& r, std::chrono::nanoseconds uptimeNanos)
 {
-    return sendMessage(obtainMessage(what));
+    return postAtTime(std::move(r), nullptr, uptimeNanos);
 }
 
-bool Handler::sendEmptyMessageAtTime(int32_t what, std::chrono::milliseconds uptimeMillis)
+bool Handler::postAtTime(std::function<void ()>&& r, const void* token, std::chrono::milliseconds uptimeMillis)
 {
-    return sendMessageAtTime(obtainMessage(what), uptimeMillis);
+    return postAtTime(runnable_t(std::move(r)), token, std::chrono::nanoseconds(uptimeMillis));
 }
 
-bool Handler::sendEmptyMessageDelayed(int32_t what, std::chrono::milliseconds delayMillis)
+bool Handler::postAtTime(runnable_t&& r, const void* token, std::chrono::nanoseconds uptimeNanos)
 {
-    return sendMessageDelayed(obtainMessage(what), delayMillis);
+    intptr_t identity = functionIdentity(r);
+    return postCallbackAtTime(std::move(r), identity, token, uptimeNanos);
 }
 
-bool Handler::sendMessage(Message& msg)
+bool Handler::postDelayed(std::function<void ()>&& r, std::chrono::milliseconds delayMillis)
 {
-    synchronized (this) {
-        enqueueWorkItem(m_workQueue, std::make_unique<MessageWorkItem>(*this, System::currentTimeMillis(), msg));
-        return start();
-    }
+    return postDelayed(runnable_t(std::move(r)), std::chrono::nanoseconds(delayMillis));
 }
 
-bool Handler::sendMessageAtFrontOfQueue(Message& msg)
+bool Handler::postDelayed(runnable_t&& r, std::chrono::nanoseconds delay)
 {
-    synchronized (this) {
-        enqueueWorkItem(m_workQueue, std::make_unique<MessageWorkItem>(*this, System::currentTimeMillis() - oneMillisecond, msg));
-        return start();
-    }
+    return postDelayed(std::move(r), nullptr, delay);
 }
 
-bool Handler::sendMessageAtTime(Message& msg, std::chrono::milliseconds uptimeMillis)
+bool Handler::postDelayed(std::function<void ()>&& r, const void* token, std::chrono::milliseconds delayMillis)
 {
-    synchronized (this) {
-        enqueueWorkItem(m_workQueue, std::make_unique<MessageWorkItem>(*this, uptimeMillis, msg));
-        return startAtTime();
-    }
+    return postDelayed(runnable_t(std::move(r)), token, std::chrono::nanoseconds(delayMillis));
 }
 
-bool Handler::sendMessageDelayed(Message& msg, std::chrono::milliseconds delayMillis)
+bool Handler::postDelayed(runnable_t&& r, const void* token, std::chrono::nanoseconds delay)
 {
-    return sendMessageAtTime(msg, System::currentTimeMillis() + delayMillis);
+    intptr_t identity = functionIdentity(r);
+    return postCallbackDelayed(std::move(r), identity, token, delay);
 }
 
-template<typename... Arguments>
-void Handler::removeWorkItems(Arguments... args)
+intptr_t Handler::functionIdentity(const std::function<void ()>& r)
 {
-    synchronized (this) {
-        std::vector<int32_t> indices;
+    if (void (* const* function)() = r.target<void(*)()>())
+        return reinterpret_cast<intptr_t>(*function);
+    return 0;
+}
 
-        int32_t i = 0;
-        for (auto& workItem : m_workQueue) {
-            if (workItem->isMessageOf(args...))
-                indices.push_back(i);
-            ++i;
-        }
+intptr_t Handler::functionIdentity(const runnable_t& r)
+{
+    if (const std::function<void ()>* function = r.target<std::function<void ()>>())
+        return functionIdentity(*function);
+    if (void (* const* function)() = r.target<void(*)()>())
+        return reinterpret_cast<intptr_t>(*function);
+    return 0;
+}
 
-        stop();
+bool Handler::postCallbackAtFrontOfQueue(runnable_t&& r, intptr_t identity)
+{
+    return m_queue->enqueueWorkItemAtFront(m_queue->createWorkItem<RunnableWorkItem>(*this, std::chrono::nanoseconds::zero(), std::move(r), identity, nullptr, m_asynchronous));
+}
 
-        for (int32_t i = indices.size() - 1; i >= 0; --i)
-            m_workQueue.erase(m_workQueue.begin() + indices[i]);
+bool Handler::postCallbackAtTime(runnable_t&& r, intptr_t identity, const void* token, std::chrono::nanoseconds uptimeNanos)
+{
+    return m_queue->enqueueWorkItem(m_queue->createWorkItem<RunnableWorkItem>(*this, uptimeNanos, std::move(r), identity, token, m_asynchronous));
+}
 
-        startAtTime();
-    }
+bool Handler::postCallbackDelayed(runnable_t&& r, intptr_t identity, const void* token, std::chrono::nanoseconds delay)
+{
+    return postCallbackAtTime(std::move(r), identity, token, m_queue->uptimeNanos() + delay);
 }
 
-bool Handler::start()
+void Handler::removeMessages(int32_t what)
 {
-    stop();
+    m_queue->removeWorkItems(WorkItem::MATCH_INDEX, { this, what, true });
+}
 
-    if (!m_workQueue.empty()) {
-        m_nextFireTime = System::currentTimeMillis();
-        return m_handler->start();
+void Handler::removeMessages(int32_t what, const void* object)
+{
+    if (!object) {
+        removeMessages(what);
+        return;
     }
 
-    return false;
+    m_queue->removeWorkItems(WorkItem::MATCH_INDEX, { this, what, true }, [=] (WorkItem& workItem) {
+        return workItem.token() == object;
+    });
 }
 
-bool Handler::startAtTime()
+bool Handler::sendEmptyMessage(int32_t what)
 {
-    if (m_workQueue.empty())
-        return false;
+    return sendMessage(obtainMessage(what));
+}
+
+bool Handler::sendEmptyMessageAtTime(int32_t what, std::chrono::milliseconds uptimeMillis)
+{
+    Message msg = obtainMessage(what);
+    return sendMessageAtTime(msg, uptimeMillis);
+}
 
-    std::chrono::milliseconds nextFireTime = m_workQueue[0]->fireTime();
-    if (nextFireTime > m_nextFireTime)
-        return true;
+bool Handler::sendEmptyMessageDelayed(int32_t what, std::chrono::milliseconds delayMillis)
+{
+    Message msg = obtainMessage(what);
+    return sendMessageDelayed(msg, delayMillis);
+}
 
-    m_nextFireTime = nextFireTime;
-    return m_handler->startAtTime(nextFireTime);
+bool Handler::sendMessage(Message& msg)
+{
+    return sendMessage(Message(msg));
 }
 
-void Handler::stop()
+bool Handler::sendMessage(Message&& msg)
 {
-    m_nextFireTime = std::chrono::milliseconds::max();
-    m_handler->stop();
+    return enqueueMessage(std::move(msg), m_queue->uptimeNanos());
 }
 
-void Handler::performMessages()
+bool Handler::sendMessageAtFrontOfQueue(Message& msg)
 {
-    if (m_workQueue.size() == 0)
-        return;
+    return sendMessageAtFrontOfQueue(Message(msg));
+}
 
-    std::chrono::milliseconds currentTime = System::currentTimeMillis();
-    std::vector<WorkItem*> firedItems;
+bool Handler::sendMessageAtFrontOfQueue(Message&& msg)
+{
+    return m_queue->enqueueWorkItemAtFront(m_queue->createWorkItem<MessageWorkItem>(*this, std::chrono::nanoseconds::zero(), std::move(msg), m_asynchronous));
+}
 
-    synchronized (this) {
-        for (auto& workItem : m_workQueue) {
-            if (workItem->fireTime() > currentTime)
-                break;
-            firedItems.push_back(workItem.release());
-        }
+bool Handler::sendMessageAtTime(Message& msg, std::chrono::nanoseconds uptimeNanos)
+{
+    return enqueueMessage(Message(msg), uptimeNanos);
+}
 
-        stop();
+bool Handler::sendMessageAtTime(Message&& msg, std::chrono::nanoseconds uptimeNanos)
+{
+    return enqueueMessage(std::move(msg), uptimeNanos);
+}
 
-        if (firedItems.size() > 0)
-            m_workQueue.erase(m_workQueue.begin(), m_workQueue.begin() + firedItems.size());
+bool Handler::sendMessageDelayed(Message& msg, std::chrono::milliseconds delayMillis)
+{
+    // Subclasses may override sendMessageAtTime() to see every message sent with a time. The deadline keeps the
+    // nanoseconds of the current time, so the message never fires before the delay has passed.
+    return sendMessageAtTime(msg, m_queue->uptimeNanos() + delayMillis);
+}
 
-        startAtTime();
-    }
+bool Handler::sendMessageDelayed(Message&& msg, std::chrono::milliseconds delayMillis)
+{
+    return enqueueMessage(std::move(msg), m_queue->uptimeNanos() + delayMillis);
+}
 
-    for (int32_t i = 0; i < firedItems.size(); i++)
-        firedItems[i]->performWork();
+bool Handler::enqueueMessage(Message&& msg, std::chrono::nanoseconds uptimeNanos)
+{
+    return m_queue->enqueueWorkItem(m_queue->createWorkItem<MessageWorkItem>(*this, uptimeNanos, std::move(msg), m_asynchronous));
 }
 
-void Handler::receivedMessage(Message& message)
+void Handler::receivedMessage(Message&& message)
 {
-    sendMessage(message);
+    sendMessage(std::move(message));
 }
 
 } // namespace os
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <android++/CompilerMacros.h>
+#include <android++/InlineFunction.h>
 #include <java/lang.h>
 
 #include <vector>
@@ -32,9 +34,11 @@
 namespace android {
 namespace os {
 
+class HandlerAwaiter;
 class HandlerProvider;
 class Looper;
 class Message;
+class MessageQueue;
 class MessageTarget;
 class WorkItem;
 
@@ -44,17 +48,43 @@ class Handler : public Object {
     friend class MessageTarget;
 public:
     typedef Handler* ptr_t;
-
+    // Callables of up to 56 bytes are stored in the posted work item itself.
+    typedef inline_function<void ()> runnable_t;
+
+    // Lanes of the message queue, highest first. Due work of a higher lane is performed before that of lower lanes,
+    // although work of a lower lane which has been passed over for too long gets its turn.
+    enum Priority {
+        // Messages take the priority of the handler they are sent through.
+        PRIORITY_DEFAULT = -1,
+        PRIORITY_INPUT,
+        PRIORITY_ANIMATION,
+        PRIORITY_NORMAL,
+        PRIORITY_BACKGROUND,
+        PRIORITY_COUNT
+    };
+
+    // Default constructor associates this handler with the Looper for the current thread.
     ANDROID_EXPORT Handler();
+    // Use the provided Looper instead of the default one.
+    ANDROID_EXPORT Handler(Looper* looper);
+    // Use the provided Looper, and make every message and runnable posted through this handler asynchronous.
+    ANDROID_EXPORT Handler(Looper* looper, bool async);
+    // Use the provided Looper, and post through this handler with the given priority.
+    ANDROID_EXPORT Handler(Looper* looper, bool async, Priority priority);
     ANDROID_EXPORT virtual ~Handler();
 
     ANDROID_EXPORT Looper* getLooper();
+    ANDROID_EXPORT Priority getPriority() const;
 
+    // Handle system messages here.
+    ANDROID_EXPORT virtual void dispatchMessage(Message& msg);
     // Subclasses must implement this to receive messages.
     ANDROID_EXPORT virtual void handleMessage(Message& msg);
 
     // Check if there are any pending posts of messages with code 'what' in the message queue.
     ANDROID_EXPORT bool hasMessages(int32_t what);
+    // Check if there are any pending posts of messages with code 'what' and whose obj is 'object' in the message queue.
+    ANDROID_EXPORT bool hasMessages(int32_t what, const void* object);
 
     // Returns a new Message from the global message pool.
     ANDROID_EXPORT Message obtainMessage();
@@ -65,18 +95,71 @@ public:
 
     // Remove any pending posts of messages with code 'what' that are in the message queue.
     ANDROID_EXPORT void removeMessages(int32_t what);
+    // Remove any pending posts of messages with code 'what' and whose obj is 'object' that are in the message queue.
+    ANDROID_EXPORT void removeMessages(int32_t what, const void* object);
 
     // Causes the std::function<void ()>&& r to be added to the message queue.
     ANDROID_EXPORT bool post(std::function<void ()>&& r);
+    ANDROID_EXPORT bool post(runnable_t&& r);
+    template<typename F> bool post(F&& r)
+    {
+        intptr_t identity = callbackIdentity<F>(r);
+        return postCallbackDelayed(runnable_t(std::forward<F>(r)), identity, nullptr, std::chrono::nanoseconds::zero());
+    }
     // Posts a message to an object that implements std::function<void ()>&&.
     ANDROID_EXPORT bool postAtFrontOfQueue(std::function<void ()>&& r);
+    ANDROID_EXPORT bool postAtFrontOfQueue(runnable_t&& r);
+    template<typename F> bool postAtFrontOfQueue(F&& r)
+    {
+        intptr_t identity = callbackIdentity<F>(r);
+        return postCallbackAtFrontOfQueue(runnable_t(std::forward<F>(r)), identity);
+    }
     // Causes the std::function<void ()>&& r to be added to the message queue, to be run at a specific time given by uptimeMillis.
+    // The time-base is SystemClock::uptimeMillis(); the runnable_t overloads take any duration down to nanoseconds.
     ANDROID_EXPORT bool postAtTime(std::function<void ()>&& r, std::chrono::milliseconds uptimeMillis);
+    ANDROID_EXPORT bool postAtTime(runnable_t&& r, std::chrono::nanoseconds uptimeNanos);
+    template<typename F, typename Rep, typename Period> bool postAtTime(F&& r, std::chrono::duration<Rep, Period> uptime)
+    {
+        return postAtTime(std::forward<F>(r), nullptr, uptime);
+    }
+    // Same as postAtTime(), but the runnable can be removed with removeCallbacksAndMessages(token).
+    ANDROID_EXPORT bool postAtTime(std::function<void ()>&& r, const void* token, std::chrono::milliseconds uptimeMillis);
+    ANDROID_EXPORT bool postAtTime(runnable_t&& r, const void* token, std::chrono::nanoseconds uptimeNanos);
+    template<typename F, typename Rep, typename Period> bool postAtTime(F&& r, const void* token, std::chrono::duration<Rep, Period> uptime)
+    {
+        intptr_t identity = callbackIdentity<F>(r);
+        return postCallbackAtTime(runnable_t(std::forward<F>(r)), identity, token, std::chrono::duration_cast<std::chrono::nanoseconds>(uptime));
+    }
     // Causes the std::function<void ()>&& r to be added to the message queue, to be run after the specified amount of time elapses.
     ANDROID_EXPORT bool postDelayed(std::function<void ()>&& r, std::chrono::milliseconds delayMillis);
-
-    // Remove any pending posts of std::function<void ()>&& r that are in the message queue.
-    ANDROID_EXPORT void removeCallbacks(std::function<void ()>&& r);
+    ANDROID_EXPORT bool postDelayed(runnable_t&& r, std::chrono::nanoseconds delay);
+    template<typename F, typename Rep, typename Period> bool postDelayed(F&& r, std::chrono::duration<Rep, Period> delay)
+    {
+        return postDelayed(std::forward<F>(r), nullptr, delay);
+    }
+    // Same as postDelayed(), but the runnable can be removed with removeCallbacksAndMessages(token).
+    ANDROID_EXPORT bool postDelayed(std::function<void ()>&& r, const void* token, std::chrono::milliseconds delayMillis);
+    ANDROID_EXPORT bool postDelayed(runnable_t&& r, const void* token, std::chrono::nanoseconds delay);
+    template<typename F, typename Rep, typename Period> bool postDelayed(F&& r, const void* token, std::chrono::duration<Rep, Period> delay)
+    {
+        intptr_t identity = callbackIdentity<F>(r);
+        return postCallbackDelayed(runnable_t(std::forward<F>(r)), identity, token, std::chrono::duration_cast<std::chrono::nanoseconds>(delay));
+    }
+
+    // Remove any pending posts of r that are in the message queue.
+    // Like a Runnable, a callback is matched by identity: r has to be the same plain function, or the very callable
+    // object that was posted, e.g. a std::function member which outlives its posts. Posts of a temporary lambda or
+    // functor can't be told apart from one another and are only removed through their token.
+    template<typename F> void removeCallbacks(F&& r) { removeCallbacks(std::forward<F>(r), nullptr); }
+    // Remove any pending posts of r with the given token that are in the message queue.
+    template<typename F> void removeCallbacks(F&& r, const void* token) { removeCallbacksWithIdentity(callbackIdentity<F>(r), token); }
+    // Remove any pending posts of callbacks and sent messages whose obj is token. If token is null, all callbacks and messages will be removed.
+    ANDROID_EXPORT void removeCallbacksAndMessages(const void* token);
+
+#if COMPILER_SUPPORTS(CXX_COROUTINES)
+    // Returns an awaitable which resumes the awaiting coroutine on the thread of this handler. Defined in Coroutine.h.
+    HandlerAwaiter resumeOn();
+#endif
 
     // Sends a Message containing only the what value.
     ANDROID_EXPORT bool sendEmptyMessage(int32_t what);
@@ -86,29 +169,51 @@ public:
     ANDROID_EXPORT bool sendEmptyMessageDelayed(int32_t what, std::chrono::milliseconds delayMillis);
 
     // Pushes a message onto the end of the message queue after all pending messages before the current time.
+    // The Message&& overloads hand the message itself over to the queue instead of posting a copy of it.
     ANDROID_EXPORT bool sendMessage(Message& msg);
+    ANDROID_EXPORT bool sendMessage(Message&& msg);
     // Enqueue a message at the front of the message queue, to be processed on the next iteration of the message loop.
     ANDROID_EXPORT bool sendMessageAtFrontOfQueue(Message& msg);
-    // Enqueue a message into the message queue after all pending messages before the absolute time (in milliseconds); uptimeMillis.
-    ANDROID_EXPORT virtual bool sendMessageAtTime(Message& msg, std::chrono::milliseconds uptimeMillis);
+    ANDROID_EXPORT bool sendMessageAtFrontOfQueue(Message&& msg);
+    // Enqueue a message into the message queue after all pending messages before the absolute time uptimeNanos.
+    // The time-base is SystemClock::uptimeNanos(); milliseconds convert implicitly. Overrides see the messages of
+    // sendMessageDelayed(Message&) and of sendEmptyMessageAtTime() and sendEmptyMessageDelayed(), but not those handed
+    // over through the Message&& overloads.
+    ANDROID_EXPORT virtual bool sendMessageAtTime(Message& msg, std::chrono::nanoseconds uptimeNanos);
+    ANDROID_EXPORT bool sendMessageAtTime(Message&& msg, std::chrono::nanoseconds uptimeNanos);
     // Enqueue a message into the message queue after all pending messages before (current time + delayMillis);.
     ANDROID_EXPORT bool sendMessageDelayed(Message& msg, std::chrono::milliseconds delayMillis);
+    ANDROID_EXPORT bool sendMessageDelayed(Message&& msg, std::chrono::milliseconds delayMillis);
 
 private:
-    template<typename... Arguments> void removeWorkItems(Arguments...);
-
-    bool start();
-    bool startAtTime();
-    void stop();
+    bool enqueueMessage(Message&&, std::chrono::nanoseconds uptimeNanos);
+
+    // A callback is identified by the plain function it calls, or else by the address of the callable object it was
+    // posted from. Callables passed as temporaries have no identity, which is 0.
+    ANDROID_EXPORT static intptr_t functionIdentity(const std::function<void ()>& r);
+    ANDROID_EXPORT static intptr_t functionIdentity(const runnable_t& r);
+    static intptr_t functionIdentity(void (*r)()) { return reinterpret_cast<intptr_t>(r); }
+    template<typename F> static intptr_t functionIdentity(const F&) { return 0; }
+    template<typename F> static intptr_t callbackIdentity(const typename std::remove_reference<F>::type& r)
+    {
+        if (intptr_t function = functionIdentity(r))
+            return function;
+        return std::is_lvalue_reference<F>::value ? reinterpret_cast<intptr_t>(std::addressof(r)) : 0;
+    }
+
+    ANDROID_EXPORT bool postCallbackAtFrontOfQueue(runnable_t&&, intptr_t identity);
+    ANDROID_EXPORT bool postCallbackAtTime(runnable_t&&, intptr_t identity, const void* token, std::chrono::nanoseconds uptimeNanos);
+    ANDROID_EXPORT bool postCallbackDelayed(runnable_t&&, intptr_t identity, const void* token, std::chrono::nanoseconds delay);
+    ANDROID_EXPORT void removeCallbacksWithIdentity(intptr_t identity, const void* token);
 
     // HandlerProvider
-    void performMessages();
-    void receivedMessage(Message&);
+    void receivedMessage(Message&&);
 
-    std::unique_ptr<HandlerProvider> m_handler;
-    std::vector<std::unique_ptr<WorkItem>> m_workQueue;
-    std::chrono::milliseconds m_nextFireTime;
     Looper* m_looper;
+    std::shared_ptr<MessageQueue> m_queue;
+    std::unique_ptr<HandlerProvider> m_handler;
+    bool m_asynchronous;
+    Priority m_priority;
 };
 
 } // namespace os
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "HandlerThread.h"
+
+#include "Looper.h"
+
+namespace android {
+namespace os {
+
+HandlerThread::HandlerThread(StringRef name)
+    : HandlerThread(name, Handler::PRIORITY_NORMAL)
+{
+}
+
+HandlerThread::HandlerThread(StringRef name, Handler::Priority priority)
+    : m_name(name)
+    , m_priority(priority)
+{
+}
+
+HandlerThread::~HandlerThread()
+{
+    quit();
+    join();
+}
+
+void HandlerThread::start()
+{
+    synchronized (this) {
+        assert(!m_started);
+        m_started = true;
+    }
+
+    m_thread = std::thread([this] { run(); });
+}
+
+Looper* HandlerThread::getLooper()
+{
+    synchronized (this) {
+        while (m_started && !m_terminated && !m_looper)
+            wait();
+        return m_looper;
+    }
+    return nullptr;
+}
+
+Handler* HandlerThread::getThreadHandler()
+{
+    if (!getLooper())
+        return nullptr;
+
+    return m_handler.get();
+}
+
+bool HandlerThread::quit()
+{
+    // The looper is deleted by the thread as soon as it stops, so it is only ever asked to quit from its own thread.
+    Handler* handler = getThreadHandler();
+    return handler && handler->postAtFrontOfQueue([] { Looper::myLooper()->quit(); });
+}
+
+bool HandlerThread::quitSafely()
+{
+    Handler* handler = getThreadHandler();
+    return handler && handler->post([] { Looper::myLooper()->quitSafely(); });
+}
+
+void HandlerThread::join()
+{
+    if (m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id())
+        m_thread.join();
+}
+
+StringRef HandlerThread::getName() const
+{
+    return m_name;
+}
+
+bool HandlerThread::isAlive()
+{
+    synchronized (this) {
+        return m_started && !m_terminated;
+    }
+    return false;
+}
+
+void HandlerThread::onLooperPrepared()
+{
+}
+
+void HandlerThread::run()
+{
+    Looper::prepare();
+
+    synchronized (this) {
+        m_looper = Looper::myLooper();
+        m_handler = std::make_unique<Handler>(m_looper, false, m_priority);
+        notifyAll();
+    }
+
+    onLooperPrepared();
+    Looper::loop();
+
+    synchronized (this) {
+        m_looper = nullptr;
+        m_terminated = true;
+        notifyAll();
+    }
+}
+
+} // namespace os
+} // namespace android
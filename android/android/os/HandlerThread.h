@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <android/os/Handler.h>
+
+#include <thread>
+
+namespace android {
+namespace os {
+
+class Looper;
+
+// A thread that has a looper. The looper can then be used to create handler classes.
+class HandlerThread : public Object {
+    NONCOPYABLE(HandlerThread);
+public:
+    ANDROID_EXPORT HandlerThread(StringRef name);
+    // The handler returned by getThreadHandler() posts with the given priority.
+    ANDROID_EXPORT HandlerThread(StringRef name, Handler::Priority priority);
+    // Quits the looper and waits for the thread to terminate.
+    ANDROID_EXPORT virtual ~HandlerThread();
+
+    // Causes this thread to begin execution.
+    ANDROID_EXPORT void start();
+    // Returns the Looper associated with this thread, waiting for it to be prepared if the thread has been started.
+    // Returns null if the thread has not been started, or has terminated.
+    ANDROID_EXPORT Looper* getLooper();
+    // Returns a shared Handler associated with this thread, or null under the same conditions as getLooper().
+    ANDROID_EXPORT Handler* getThreadHandler();
+
+    // Quits the handler thread's looper, discarding any pending messages.
+    ANDROID_EXPORT bool quit();
+    // Quits the handler thread's looper safely, after pending messages that are already due have been handled.
+    ANDROID_EXPORT bool quitSafely();
+    // Waits for this thread to terminate.
+    ANDROID_EXPORT void join();
+
+    ANDROID_EXPORT StringRef getName() const;
+    ANDROID_EXPORT bool isAlive();
+
+protected:
+    // Call back method that can be explicitly overridden if needed to execute some setup before Looper loops.
+    ANDROID_EXPORT virtual void onLooperPrepared();
+
+private:
+    void run();
+
+    String m_name;
+    Handler::Priority m_priority;
+    std::thread m_thread;
+    bool m_started { false };
+    bool m_terminated { false };
+    Looper* m_looper { nullptr };
+    std::unique_ptr<Handler> m_handler;
+};
+
+} // namespace os
+} // namespace android
+
+using HandlerThread = android::os::HandlerThread;
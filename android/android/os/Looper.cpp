@@ -25,15 +25,25 @@
 
 #include "Looper.h"
 
+#include <android/os/LooperMetrics.h>
+#include <android/os/Watchdog.h>
+#include <android/util/Printer.h>
+
 namespace android {
 namespace os {
 
 Looper::Looper()
+    : m_tid(platformGetThreadId())
+    , m_queue(new MessageQueue(m_tid))
 {
+    Watchdog::shared().addQueue(m_queue);
 }
 
 Looper::~Looper()
 {
+    Watchdog::shared().removeQueue(m_queue.get());
+    // Handlers may outlive their looper, but nothing they post from now on is going to be dispatched.
+    m_queue->dispose();
 }
 
 static Looper* mainLooper;
@@ -53,6 +63,11 @@ Looper* Looper::myLooper()
     return threadLooper;
 }
 
+MessageQueue* Looper::myQueue()
+{
+    return threadLooper ? threadLooper->getQueue() : nullptr;
+}
+
 void Looper::prepareMainLooper()
 {
     if (mainLooper)
@@ -71,27 +86,82 @@ void Looper::prepare()
         return;
 
     threadLooper = new Looper();
-    threadLooper->m_tid = platformGetThreadId();
+}
+
+void Looper::prepareVirtualTime()
+{
+    prepare();
+    threadLooper->m_queue->useVirtualTime();
 }
 
 void Looper::loop()
 {
-    assert(threadLooper);
+    assert(threadLooper && !threadLooper->m_queue->usesVirtualTime());
 
     platformLooperLoop();
 
+    if (mainLooper == threadLooper)
+        mainLooper = nullptr;
+
     delete threadLooper;
+    threadLooper = nullptr;
 }
 
 void Looper::quit()
 {
+    m_queue->quit(false);
     platformLooperQuit(m_tid, 0);
 }
 
 void Looper::quitSafely()
 {
+    m_queue->quit(true);
     platformLooperQuit(m_tid, 0);
 }
 
+MessageQueue* Looper::getQueue()
+{
+    return m_queue.get();
+}
+
+void Looper::advanceBy(std::chrono::nanoseconds duration)
+{
+    assert(threadLooper == this);
+    m_queue->advanceVirtualTime(duration);
+}
+
+void Looper::runUntilIdle()
+{
+    advanceBy(std::chrono::nanoseconds::zero());
+}
+
+void Looper::setMessageLogging(util::Printer* printer)
+{
+    m_queue->m_metrics->setMessageLogging(printer);
+}
+
+void Looper::setSlowLogThresholdMs(std::chrono::milliseconds slowDispatchThresholdMs, std::chrono::milliseconds slowDeliveryThresholdMs)
+{
+    m_queue->m_metrics->setSlowLogThresholds(slowDispatchThresholdMs, slowDeliveryThresholdMs);
+}
+
+void Looper::setMetricsEnabled(bool enabled)
+{
+    m_queue->m_metrics->setEnabled(enabled);
+}
+
+void Looper::setStallThresholdMs(std::chrono::milliseconds thresholdMs, util::Printer* printer)
+{
+    Watchdog::shared().setStallThreshold(thresholdMs, printer);
+}
+
+void Looper::dump(util::Printer& pw, const char* prefix)
+{
+    char line[256];
+    snprintf(line, sizeof(line), "%sLooper (tid=%lld) {%p}", prefix, static_cast<long long>(m_tid), this);
+    pw.println(line);
+    m_queue->m_metrics->dump(pw, prefix);
+}
+
 } // namespace os
 } // namespace android
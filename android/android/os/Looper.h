@@ -26,24 +26,37 @@
 #pragma once
 
 #include <android/os/Message.h>
+#include <android/os/MessageQueue.h>
 
 namespace android {
+namespace util {
+class Printer;
+}
 namespace os {
 
+class Handler;
 class LooperHolder;
 
 class Looper {
     NONCOPYABLE(Looper);
+    friend class CoroutineFrame;
+    friend class Handler;
 public:
     // Returns the application's main looper, which lives in the main thread of the application.
     ANDROID_EXPORT static Looper* getMainLooper();
     // Return the Looper object associated with the current thread.
     ANDROID_EXPORT static Looper* myLooper();
+    // Return the MessageQueue object associated with the current thread.
+    ANDROID_EXPORT static MessageQueue* myQueue();
 
     // Initialize the current thread as a looper, marking it as an application's main looper.
     ANDROID_EXPORT static void prepareMainLooper();
     // Initialize the current thread as a looper.
     ANDROID_EXPORT static void prepare();
+    // Initialize the current thread as a looper, or switch its looper, to run on a virtual clock. Meant for tests:
+    // the clock only moves in advanceBy() or SystemClock::sleep(), SystemClock reports it on this thread, and work
+    // is performed by advanceBy() and runUntilIdle() instead of loop().
+    ANDROID_EXPORT static void prepareVirtualTime();
 
     // Run the message queue in this thread.
     ANDROID_EXPORT static void loop();
@@ -53,6 +66,26 @@ public:
     // Quits the looper safely.
     ANDROID_EXPORT virtual void quitSafely();
 
+    // Gets this looper's message queue.
+    ANDROID_EXPORT MessageQueue* getQueue();
+
+    // Virtual time only: moves the clock forward by the given amount, performing the work which falls due in order.
+    ANDROID_EXPORT void advanceBy(std::chrono::nanoseconds duration);
+    // Virtual time only: performs the work which is due, including any it posts in turn for the current time.
+    ANDROID_EXPORT void runUntilIdle();
+
+    // Control logging of messages as they are processed by this Looper. Pass null to disable it.
+    ANDROID_EXPORT void setMessageLogging(util::Printer* printer);
+    // Logs a warning for messages which run longer than slowDispatchThresholdMs, or start more than slowDeliveryThresholdMs late. Zero disables either check.
+    ANDROID_EXPORT void setSlowLogThresholdMs(std::chrono::milliseconds slowDispatchThresholdMs, std::chrono::milliseconds slowDeliveryThresholdMs);
+    // Enables collection of time in queue, dispatch time, queue depth and dispatch counts per what and callback.
+    ANDROID_EXPORT void setMetricsEnabled(bool enabled);
+    // Reports any looper of the process which has been dispatching one message or callback for longer than thresholdMs,
+    // with the stack of its thread, to the printer or else the error log. Checked from a watchdog thread; zero stops it.
+    ANDROID_EXPORT static void setStallThresholdMs(std::chrono::milliseconds thresholdMs, util::Printer* printer = nullptr);
+    // Dumps the state of the looper for debugging purposes.
+    ANDROID_EXPORT void dump(util::Printer& pw, const char* prefix);
+
 private:
     Looper();
     ~Looper();
@@ -62,7 +95,8 @@ private:
     static void platformLooperLoop();
     static void platformLooperQuit(int64_t, int32_t);
 
-    int64_t m_tid { 0 };
+    int64_t m_tid;
+    std::shared_ptr<MessageQueue> m_queue;
 };
 
 } // namespace os
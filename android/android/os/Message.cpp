@@ -28,6 +28,7 @@
 #include <android/os/Binder.h>
 #include <android/os/Bundle.h>
 #include <android/os/BundlePrivate.h>
+#include <android/os/MessagePool.h>
 #include <android/os/Messenger.h>
 #include <android/os/ParcelPrivate.h>
 #include <android/os/ParcelablePrivate.h>
@@ -42,6 +43,8 @@ Message::Message()
     , target(0)
     , replyTo(0)
     , data(nullptr)
+    , asynchronous(false)
+    , priority(Handler::PRIORITY_DEFAULT)
 {
 }
 
@@ -52,7 +55,9 @@ Message::Message(const Message& o)
     , obj(o.obj)
     , target(o.target)
     , replyTo(o.replyTo)
-    , data((o.data) ? new Bundle(*o.data) : nullptr)
+    , data((o.data) ? MessagePool::obtainData(*o.data) : nullptr)
+    , asynchronous(o.asynchronous)
+    , priority(o.priority)
 {
 }
 
@@ -64,6 +69,8 @@ Message::Message(Message&& o)
     , target(o.target)
     , replyTo(o.replyTo)
     , data(o.data)
+    , asynchronous(o.asynchronous)
+    , priority(o.priority)
 {
     o.replyTo = nullptr;
     o.data = nullptr;
@@ -71,18 +78,28 @@ Message::Message(Message&& o)
 
 Message& Message::operator=(const Message& other)
 {
+    if (this == &other)
+        return *this;
+
+    MessagePool::recycleData(data);
     what = other.what;
     arg1 = other.arg1;
     arg2 = other.arg2;
     obj = other.obj;
     target = other.target;
     replyTo = other.replyTo;
-    data = (other.data) ? new Bundle(*other.data) : nullptr;
+    data = (other.data) ? MessagePool::obtainData(*other.data) : nullptr;
+    asynchronous = other.asynchronous;
+    priority = other.priority;
     return *this;
 }
 
 Message& Message::operator=(Message&& other)
 {
+    if (this == &other)
+        return *this;
+
+    MessagePool::recycleData(data);
     what = other.what;
     arg1 = other.arg1;
     arg2 = other.arg2;
@@ -92,13 +109,14 @@ Message& Message::operator=(Message&& other)
     other.replyTo = nullptr;
     data = other.data;
     other.data = nullptr;
+    asynchronous = other.asynchronous;
+    priority = other.priority;
     return *this;
 }
 
 Message::~Message()
 {
-    if (data)
-        delete data;
+    MessagePool::recycleData(data);
 }
 
 Message Message::obtain()
@@ -160,30 +178,72 @@ Message Message::obtain(const Message& orig)
     m.obj = orig.obj;
     m.target = orig.target;
     m.replyTo = orig.replyTo;
-    m.data = (orig.data) ? new Bundle(*orig.data) : nullptr;
+    m.data = (orig.data) ? MessagePool::obtainData(*orig.data) : nullptr;
     return m;
 }
 
-void Message::setData(Bundle& data)
+void Message::recycle()
 {
-    if (this->data)
-        delete this->data;
+    what = 0;
+    arg1 = 0;
+    arg2 = 0;
+    obj = std::proxy_ptr<Parcelable>();
+    target = 0;
+    replyTo = nullptr;
+    MessagePool::recycleData(data);
+    data = nullptr;
+    asynchronous = false;
+    priority = Handler::PRIORITY_DEFAULT;
+}
 
-    this->data = new Bundle(data);
+int64_t Message::getPoolHitCount()
+{
+    return MessagePool::hitCount();
 }
 
-void Message::setData(Bundle&& data)
+int64_t Message::getPoolMissCount()
 {
-    if (this->data)
-        delete this->data;
+    return MessagePool::missCount();
+}
+
+bool Message::isAsynchronous() const
+{
+    return asynchronous;
+}
+
+void Message::setAsynchronous(bool async)
+{
+    asynchronous = async;
+}
 
-    this->data = new Bundle(data);
+Handler::Priority Message::getPriority() const
+{
+    return priority;
+}
+
+void Message::setPriority(Handler::Priority priority)
+{
+    this->priority = priority;
+}
+
+void Message::setData(Bundle& data)
+{
+    Bundle* oldData = this->data;
+    this->data = MessagePool::obtainData(data);
+    MessagePool::recycleData(oldData);
+}
+
+void Message::setData(Bundle&& data)
+{
+    Bundle* oldData = this->data;
+    this->data = MessagePool::obtainData(data);
+    MessagePool::recycleData(oldData);
 }
 
 Bundle& Message::getData()
 {
     if (!data)
-        data = new Bundle;
+        data = MessagePool::obtainData();
 
     return *data;
 }
@@ -205,7 +265,7 @@ public:
         source >> hasObj;
         if (hasObj) {
             auto obj = ParcelablePrivate::createFromParcel(source);
-            result->obj = BundlePrivate::getPrivate(result->getData()).setMessageObj(obj);
+            result->obj = BundlePrivate::getMutablePrivate(result->getData()).setMessageObj(obj);
         }
         intptr_t handle;
         source >> handle;
@@ -214,9 +274,9 @@ public:
         bool hasData;
         source >> hasData;
         if (hasData) {
-            String binaryName;
-            source >> binaryName;
-            assert(binaryName == ParcelableCreator::creator<Bundle>().binaryName);
+            int32_t typeId;
+            source >> typeId;
+            assert(typeId == ParcelableCreator::creator<Bundle>().typeId);
             result->getData().readFromParcel(source);
         }
         return result;
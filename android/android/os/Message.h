@@ -51,7 +51,6 @@ public:
     ANDROID_EXPORT Message& operator=(Message&&);
     ANDROID_EXPORT ~Message();
 
-    // FIXME: Implement a global pool for obtain()s.
     // Return a new Message instance from the global pool.
     ANDROID_EXPORT static Message obtain();
 
@@ -71,6 +70,24 @@ public:
     // Same as obtain(), but copies the values of an existing message (including its target) into the new one.
     ANDROID_EXPORT static Message obtain(const Message& orig);
 
+    // Return a Message instance to the global pool.
+    ANDROID_EXPORT void recycle();
+
+    // Returns how many times the global pool had storage to hand out.
+    ANDROID_EXPORT static int64_t getPoolHitCount();
+    // Returns how many times the global pool had to allocate storage.
+    ANDROID_EXPORT static int64_t getPoolMissCount();
+
+    // Returns true if the message is asynchronous, meaning that it is not subject to Looper synchronization barriers.
+    ANDROID_EXPORT bool isAsynchronous() const;
+    // Sets whether the message is asynchronous, meaning that it is not subject to Looper synchronization barriers.
+    ANDROID_EXPORT void setAsynchronous(bool async);
+
+    // Returns the priority the message is delivered with.
+    ANDROID_EXPORT Handler::Priority getPriority() const;
+    // Sets the priority the message is delivered with. PRIORITY_DEFAULT delivers it with the priority of its handler.
+    ANDROID_EXPORT void setPriority(Handler::Priority priority);
+
     // Sets a Bundle of arbitrary data values. 
     ANDROID_EXPORT void setData(Bundle& data);
     ANDROID_EXPORT void setData(Bundle&& data);
@@ -87,6 +104,8 @@ public:
 
 private:
     mutable Bundle* data;
+    bool asynchronous;
+    Handler::Priority priority;
 };
 
 } // namespace os
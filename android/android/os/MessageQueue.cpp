@@ -0,0 +1,600 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MessageQueue.h"
+
+#include <android/os/Looper.h>
+#include <android/os/LooperMetrics.h>
+#include <android/os/MessageQueueProvider.h>
+#include <android/os/SystemClock.h>
+#include <android/os/WorkItem.h>
+#include <android/os/WorkQueue.h>
+
+#include <android++/LogHelper.h>
+#include <algorithm>
+
+
+namespace android {
+namespace os {
+
+// Items posted at the front of the queue fire at time zero. Their sequence counts downwards, so the most recent
+// one is performed first.
+static const std::chrono::nanoseconds frontOfQueue = std::chrono::nanoseconds::zero();
+
+// Due work of a lower lane is performed at the latest after it has been passed over this many times in a row.
+static const int32_t maxPassedOver = 8;
+
+// A dispatch which has run for longer than this performs only input work, and leaves the rest to the next wake up.
+// This returns to the thread's event loop, so events from the window system aren't held up behind long runs of work.
+static const std::chrono::nanoseconds dispatchTimeSlice = std::chrono::milliseconds(4);
+
+static bool firesBefore(const WorkItem& item, std::chrono::nanoseconds fireTime, int64_t sequence)
+{
+    if (item.fireTime() != fireTime)
+        return item.fireTime() < fireTime;
+    return item.sequence() < sequence;
+}
+
+MessageQueue::MessageQueue(int64_t tid)
+    : m_tid(tid)
+    , m_allocator(std::make_unique<WorkItemAllocator>())
+    , m_metrics(std::make_unique<LooperMetrics>())
+    , m_provider(std::make_unique<MessageQueueProvider>(*this))
+    , m_nextFireTime(std::chrono::nanoseconds::max())
+{
+    for (Lane& lane : m_lanes) {
+        lane.workQueue = std::make_unique<WorkQueue>();
+        lane.asynchronousWorkQueue = std::make_unique<WorkQueue>();
+    }
+}
+
+MessageQueue::~MessageQueue()
+{
+    WorkItem* item = m_incomingWorkItems.exchange(nullptr);
+    while (item) {
+        WorkItem* next = item->m_nextIncoming;
+        delete item;
+        item = next;
+    }
+}
+
+bool MessageQueue::isIdle()
+{
+    std::chrono::nanoseconds currentTime = uptimeNanos();
+    synchronized (this) {
+        drainIncomingWorkItems();
+        WorkQueue* queue = nextWorkQueue();
+        return !queue || queue->top().fireTime() > currentTime;
+    }
+    return true;
+}
+
+void MessageQueue::addIdleHandler(IdleHandler* handler)
+{
+    assert(handler);
+    synchronized (this) {
+        m_idleHandlers.push_back(handler);
+    }
+}
+
+void MessageQueue::removeIdleHandler(IdleHandler* handler)
+{
+    synchronized (this) {
+        m_idleHandlers.erase(std::remove(m_idleHandlers.begin(), m_idleHandlers.end(), handler), m_idleHandlers.end());
+    }
+}
+
+int32_t MessageQueue::postSyncBarrier()
+{
+    std::chrono::nanoseconds currentTime = uptimeNanos();
+    synchronized (this) {
+        // Work posted from other threads before the barrier must be ordered before it.
+        drainIncomingWorkItems();
+        int32_t token = m_nextBarrierToken++;
+        m_syncBarriers.push_back({ token, currentTime, m_nextSequence++ });
+        return token;
+    }
+    return -1;
+}
+
+void MessageQueue::removeSyncBarrier(int32_t token)
+{
+    synchronized (this) {
+        auto barrier = std::find_if(m_syncBarriers.begin(), m_syncBarriers.end(), [=] (const SyncBarrier& syncBarrier) {
+            return syncBarrier.token == token;
+        });
+        if (barrier == m_syncBarriers.end()) {
+            LOGE("%s", "The specified message queue synchronization barrier token has not been posted or has already been removed.");
+            return;
+        }
+
+        bool wasBlocking = barrier == m_syncBarriers.begin();
+        m_syncBarriers.erase(barrier);
+        if (wasBlocking)
+            schedule();
+    }
+}
+
+void MessageQueue::addOnFileDescriptorEventListener(int32_t fd, int32_t events, OnFileDescriptorEventListener* listener)
+{
+    assert(fd >= 0 && listener);
+    synchronized (this) {
+        updateOnFileDescriptorEventListener(fd, events, listener);
+    }
+}
+
+void MessageQueue::removeOnFileDescriptorEventListener(int32_t fd)
+{
+    synchronized (this) {
+        updateOnFileDescriptorEventListener(fd, 0, nullptr);
+    }
+}
+
+bool MessageQueue::enqueueWorkItem(std::unique_ptr<WorkItem>&& item)
+{
+    if (Looper::myQueue() != this)
+        return enqueueForeignWorkItem(std::move(item));
+
+    synchronized (this) {
+        if (m_quitting)
+            return false;
+
+        item->m_sequence = m_nextSequence++;
+        workQueueFor(*item).push(std::move(item));
+        return schedule();
+    }
+    return false;
+}
+
+bool MessageQueue::enqueueForeignWorkItem(std::unique_ptr<WorkItem>&& item)
+{
+    if (m_quitting)
+        return false;
+
+    // Producers never touch the queue lock. The item is pushed onto the incoming list, and only the producer which
+    // finds no wake up pending goes on to start the provider.
+    WorkItem* incomingItem = item.release();
+    incomingItem->m_nextIncoming = m_incomingWorkItems.load(std::memory_order_relaxed);
+    while (!m_incomingWorkItems.compare_exchange_weak(incomingItem->m_nextIncoming, incomingItem,
+        std::memory_order_seq_cst, std::memory_order_relaxed)) { }
+
+    // Under a burst the flag is mostly set already, and a load keeps its cache line shared between producers
+    // where an exchange would take it over every time. The load is ordered after the push, as dispatchWorkItems()
+    // orders the drain after clearing the flag, so a producer which sees it set has its item drained.
+    if (m_wakeUpPending.load() || m_wakeUpPending.exchange(true))
+        return true;
+
+    synchronized (this) {
+        if (m_provider && !usesVirtualTime())
+            return m_provider->start();
+    }
+    return true;
+}
+
+void MessageQueue::drainIncomingWorkItems()
+{
+    WorkItem* item = m_incomingWorkItems.exchange(nullptr);
+    if (!item)
+        return;
+
+    // The list is in reverse posting order.
+    WorkItem* reversed = nullptr;
+    while (item) {
+        WorkItem* next = item->m_nextIncoming;
+        item->m_nextIncoming = reversed;
+        reversed = item;
+        item = next;
+    }
+
+    while (reversed) {
+        WorkItem* next = reversed->m_nextIncoming;
+        reversed->m_nextIncoming = nullptr;
+        reversed->m_sequence = m_nextSequence++;
+        workQueueFor(*reversed).push(std::unique_ptr<WorkItem>(reversed));
+        reversed = next;
+    }
+}
+
+bool MessageQueue::enqueueWorkItemAtFront(std::unique_ptr<WorkItem>&& item)
+{
+    item->m_fireTime = frontOfQueue;
+    synchronized (this) {
+        if (m_quitting)
+            return false;
+
+        item->m_sequence = --m_nextFrontSequence;
+        workQueueFor(*item).push(std::move(item));
+        return schedule();
+    }
+    return false;
+}
+
+bool MessageQueue::hasWorkItems(int32_t index, const WorkItemKey& key, const std::function<bool (WorkItem&)>& filter)
+{
+    synchronized (this) {
+        drainIncomingWorkItems();
+        for (Lane& lane : m_lanes) {
+            if (lane.workQueue->contains(static_cast<WorkItem::Index>(index), key, filter)
+                || lane.asynchronousWorkQueue->contains(static_cast<WorkItem::Index>(index), key, filter))
+                return true;
+        }
+    }
+    return false;
+}
+
+void MessageQueue::removeWorkItems(int32_t index, const WorkItemKey& key, const std::function<bool (WorkItem&)>& filter)
+{
+    // Removed items are destroyed outside of the lock, since releasing what they captured may post again.
+    WorkItemChain removedItems;
+
+    synchronized (this) {
+        drainIncomingWorkItems();
+        for (Lane& lane : m_lanes) {
+            lane.workQueue->remove(static_cast<WorkItem::Index>(index), key, filter, removedItems);
+            lane.asynchronousWorkQueue->remove(static_cast<WorkItem::Index>(index), key, filter, removedItems);
+        }
+        if (!removedItems.empty())
+            unscheduleIfEmpty();
+    }
+}
+
+void MessageQueue::removeAllWorkItems(const std::function<bool (WorkItem&)>& filter)
+{
+    WorkItemChain removedItems;
+
+    synchronized (this) {
+        drainIncomingWorkItems();
+        for (Lane& lane : m_lanes) {
+            lane.workQueue->removeAll(filter, removedItems);
+            lane.asynchronousWorkQueue->removeAll(filter, removedItems);
+        }
+        if (!removedItems.empty())
+            unscheduleIfEmpty();
+    }
+}
+
+void MessageQueue::quit(bool safe)
+{
+    if (m_quitting.exchange(true))
+        return;
+
+    if (!safe) {
+        removeAllWorkItems([] (WorkItem&) { return true; });
+        return;
+    }
+
+    // Work which is already due is still delivered before the looper terminates.
+    std::chrono::nanoseconds currentTime = uptimeNanos();
+    removeAllWorkItems([=] (WorkItem& workItem) {
+        return workItem.fireTime() > currentTime;
+    });
+}
+
+void MessageQueue::dispose()
+{
+    quit(false);
+
+    std::unique_ptr<MessageQueueProvider> provider;
+    synchronized (this) {
+        for (auto& record : m_fileDescriptorRecords)
+            platformUnwatchFileDescriptor(record.first);
+        m_fileDescriptorRecords.clear();
+        m_idleHandlers.clear();
+        provider = std::move(m_provider);
+    }
+
+    if (SystemClock::threadVirtualUptime() == &m_virtualUptime)
+        SystemClock::threadVirtualUptime() = nullptr;
+}
+
+std::chrono::nanoseconds MessageQueue::uptimeNanos() const
+{
+    int64_t virtualUptime = m_virtualUptime.load(std::memory_order_relaxed);
+    return (virtualUptime < 0) ? SystemClock::steadyUptimeNanos() : std::chrono::nanoseconds(virtualUptime);
+}
+
+void MessageQueue::useVirtualTime()
+{
+    assert(Looper::myQueue() == this);
+    if (usesVirtualTime())
+        return;
+
+    // The clock starts at the current uptime, so that work which is already pending keeps its schedule.
+    synchronized (this) {
+        m_virtualUptime = SystemClock::steadyUptimeNanos().count();
+        m_nextFireTime = std::chrono::nanoseconds::max();
+        if (m_provider)
+            m_provider->stop();
+    }
+
+    SystemClock::threadVirtualUptime() = &m_virtualUptime;
+}
+
+void MessageQueue::advanceVirtualTime(std::chrono::nanoseconds duration)
+{
+    assert(usesVirtualTime() && Looper::myQueue() == this);
+    std::chrono::nanoseconds targetTime = uptimeNanos() + duration;
+
+    // The clock stops at the fire time of each piece of work, so it all runs in the order it would in real time.
+    while (true) {
+        std::chrono::nanoseconds nextFireTime = std::chrono::nanoseconds::max();
+        synchronized (this) {
+            drainIncomingWorkItems();
+            if (WorkQueue* queue = nextWorkQueue())
+                nextFireTime = queue->top().fireTime();
+        }
+
+        if (nextFireTime > targetTime && nextFireTime > uptimeNanos())
+            break;
+
+        if (nextFireTime > uptimeNanos())
+            m_virtualUptime = nextFireTime.count();
+        dispatchWorkItems();
+    }
+
+    // SystemClock::sleep() in the work may have moved the clock past the target already.
+    if (targetTime > uptimeNanos())
+        m_virtualUptime = targetTime.count();
+}
+
+WorkQueue& MessageQueue::workQueueFor(const WorkItem& item)
+{
+    Lane& lane = m_lanes[item.priority()];
+    return item.isAsynchronous() ? *lane.asynchronousWorkQueue : *lane.workQueue;
+}
+
+WorkQueue* MessageQueue::nextWorkQueue(const Lane& lane)
+{
+    WorkQueue* queue = nullptr;
+    if (!lane.workQueue->empty()) {
+        // Synchronous work ordered after the first barrier waits until that barrier is removed.
+        const SyncBarrier* barrier = m_syncBarriers.empty() ? nullptr : &m_syncBarriers.front();
+        if (!barrier || firesBefore(lane.workQueue->top(), barrier->fireTime, barrier->sequence))
+            queue = lane.workQueue.get();
+    }
+
+    if (!lane.asynchronousWorkQueue->empty()) {
+        const WorkItem& item = lane.asynchronousWorkQueue->top();
+        if (!queue || firesBefore(item, queue->top().fireTime(), queue->top().sequence()))
+            queue = lane.asynchronousWorkQueue.get();
+    }
+
+    return queue;
+}
+
+WorkQueue* MessageQueue::nextWorkQueue()
+{
+    WorkQueue* nextQueue = nullptr;
+    for (const Lane& lane : m_lanes) {
+        WorkQueue* queue = nextWorkQueue(lane);
+        if (queue && (!nextQueue || firesBefore(queue->top(), nextQueue->top().fireTime(), nextQueue->top().sequence())))
+            nextQueue = queue;
+    }
+
+    return nextQueue;
+}
+
+WorkQueue* MessageQueue::nextDueWorkQueue(std::chrono::nanoseconds currentTime, std::chrono::nanoseconds inputTime)
+{
+    WorkQueue* dueQueue = nullptr;
+    Lane* dueLane = nullptr;
+    for (Lane& lane : m_lanes) {
+        WorkQueue* queue = nextWorkQueue(lane);
+        std::chrono::nanoseconds dueTime = (&lane == &m_lanes[Handler::PRIORITY_INPUT]) ? inputTime : currentTime;
+        if (!queue || queue->top().fireTime() > dueTime) {
+            lane.passedOver = 0;
+            continue;
+        }
+
+        if (!dueQueue) {
+            dueQueue = queue;
+            dueLane = &lane;
+            continue;
+        }
+
+        // A lane which has been passed over too often takes the turn of the higher one.
+        if (lane.passedOver >= maxPassedOver) {
+            ++dueLane->passedOver;
+            dueQueue = queue;
+            dueLane = &lane;
+        } else {
+            ++lane.passedOver;
+        }
+    }
+
+    if (dueLane)
+        dueLane->passedOver = 0;
+    return dueQueue;
+}
+
+size_t MessageQueue::size() const
+{
+    size_t size = 0;
+    for (const Lane& lane : m_lanes)
+        size += lane.workQueue->size() + lane.asynchronousWorkQueue->size();
+    return size;
+}
+
+void MessageQueue::runIdleHandlers()
+{
+    std::vector<IdleHandler*> idleHandlers;
+    std::chrono::nanoseconds currentTime = uptimeNanos();
+    synchronized (this) {
+        if (m_quitting || m_idleHandlers.empty())
+            return;
+
+        WorkQueue* queue = nextWorkQueue();
+        if (queue && queue->top().fireTime() <= currentTime)
+            return;
+
+        idleHandlers = m_idleHandlers;
+    }
+
+    for (IdleHandler* idleHandler : idleHandlers) {
+        if (idleHandler->queueIdle())
+            continue;
+
+        removeIdleHandler(idleHandler);
+    }
+}
+
+bool MessageQueue::schedule()
+{
+    WorkQueue* queue = nextWorkQueue();
+    if (!queue || !m_provider || usesVirtualTime())
+        return true;
+
+    std::chrono::nanoseconds nextFireTime = queue->top().fireTime();
+    if (nextFireTime >= m_nextFireTime)
+        return true;
+
+    m_nextFireTime = nextFireTime;
+    return m_provider->startAtTime(nextFireTime);
+}
+
+void MessageQueue::unscheduleIfEmpty()
+{
+    if (nextWorkQueue() || !m_provider)
+        return;
+
+    m_nextFireTime = std::chrono::nanoseconds::max();
+    m_provider->stop();
+}
+
+void MessageQueue::updateOnFileDescriptorEventListener(int32_t fd, int32_t events, OnFileDescriptorEventListener* listener)
+{
+    if (!events || !listener) {
+        if (m_fileDescriptorRecords.erase(fd))
+            platformUnwatchFileDescriptor(fd);
+        return;
+    }
+
+    if (!m_provider || !platformWatchFileDescriptor(fd, events))
+        return;
+
+    m_fileDescriptorRecords[fd] = { events, listener };
+}
+
+void MessageQueue::dispatchFileDescriptorEvents(int32_t fd, int32_t events)
+{
+    OnFileDescriptorEventListener* listener;
+    int32_t oldWatchedEvents;
+    synchronized (this) {
+        auto record = m_fileDescriptorRecords.find(fd);
+        if (record == m_fileDescriptorRecords.end())
+            return;
+        listener = record->second.listener;
+        oldWatchedEvents = record->second.events;
+    }
+
+    events &= oldWatchedEvents | OnFileDescriptorEventListener::EVENT_ERROR;
+    if (!events)
+        return;
+
+    int32_t newWatchedEvents = listener->onFileDescriptorEvents(fd, events);
+    if (newWatchedEvents == oldWatchedEvents)
+        return;
+
+    // The listener may have been replaced or removed while it was running.
+    synchronized (this) {
+        auto record = m_fileDescriptorRecords.find(fd);
+        if (record != m_fileDescriptorRecords.end() && record->second.listener == listener && record->second.events == oldWatchedEvents)
+            updateOnFileDescriptorEventListener(fd, newWatchedEvents, listener);
+    }
+}
+
+void MessageQueue::dispatchWorkItems()
+{
+    // Only work which is due when the dispatch starts is performed. Anything posted meanwhile waits for the
+    // next wake up, so a busy queue can't starve the rest of the thread's event loop. Input is the exception: it
+    // is picked up between items against a fresh clock, so it doesn't wait behind a long run of other work.
+    std::chrono::nanoseconds currentTime = uptimeNanos();
+    std::chrono::nanoseconds inputTime = currentTime;
+
+    // Cleared before draining, so a post racing with the drain either lands in it or wakes the looper again.
+    m_wakeUpPending = false;
+
+    synchronized (this) {
+        m_nextFireTime = std::chrono::nanoseconds::max();
+        drainIncomingWorkItems();
+    }
+
+    bool yielding = false;
+    while (true) {
+        bool observing = m_metrics->isObserving();
+        std::unique_ptr<WorkItem> firedItem;
+        size_t queueDepth = 0;
+        synchronized (this) {
+            WorkQueue* queue;
+            if (!yielding) {
+                queue = nextDueWorkQueue(currentTime, inputTime);
+            } else {
+                queue = nextWorkQueue(m_lanes[Handler::PRIORITY_INPUT]);
+                if (queue && queue->top().fireTime() > inputTime)
+                    queue = nullptr;
+            }
+            if (queue)
+                firedItem = queue->pop();
+            if (observing)
+                queueDepth = size();
+        }
+
+        if (!firedItem)
+            break;
+
+        if (!observing) {
+            firedItem->performWork();
+        } else {
+            LooperMetrics::DispatchRecord record = m_metrics->dispatchStarting(*firedItem, queueDepth);
+            firedItem->performWork();
+            m_metrics->dispatchFinished(record);
+        }
+
+        // Items posted from other threads since the last drain are taken in, so that input among them is seen.
+        if (m_wakeUpPending.load(std::memory_order_relaxed)) {
+            m_wakeUpPending = false;
+            synchronized (this) {
+                drainIncomingWorkItems();
+            }
+        }
+
+        // Work left over when quitting safely is still delivered in this dispatch. Virtual time has no event loop to
+        // return to.
+        if (!m_quitting && !usesVirtualTime()) {
+            inputTime = uptimeNanos();
+            yielding = yielding || inputTime - currentTime > dispatchTimeSlice;
+        }
+    }
+
+    // The thread is about to wait for more work, unless something became due in the meantime.
+    runIdleHandlers();
+
+    synchronized (this) {
+        schedule();
+    }
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <android/os/Handler.h>
+#include <java/lang.h>
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+namespace android {
+namespace os {
+
+class Handler;
+class Looper;
+class LooperMetrics;
+class MessageQueueProvider;
+class WorkItem;
+class WorkItemAllocator;
+class WorkQueue;
+struct WorkItemKey;
+
+class MessageQueue final : public Object {
+    NONCOPYABLE(MessageQueue);
+    friend class CoroutineFrame;
+    friend class Handler;
+    friend class Looper;
+    friend class MessageQueueProvider;
+    friend class Watchdog;
+public:
+    // A listener which is invoked when file descriptor related events occur.
+    class OnFileDescriptorEventListener {
+    public:
+        // File descriptor event: Indicates whether a file descriptor is ready for input operations, such as reading.
+        static const int32_t EVENT_INPUT = 1 << 0;
+        // File descriptor event: Indicates whether a file descriptor is ready for output operations, such as writing.
+        static const int32_t EVENT_OUTPUT = 1 << 1;
+        // File descriptor event: Indicates whether a file descriptor encountered a fatal error.
+        static const int32_t EVENT_ERROR = 1 << 2;
+
+        virtual ~OnFileDescriptorEventListener() = default;
+
+        // Called when a file descriptor receives events. Returns the new set of events to watch, or 0 to unregister.
+        virtual int32_t onFileDescriptorEvents(int32_t fd, int32_t events) = 0;
+    };
+
+    // Callback interface for discovering when a thread is going to block waiting for more messages.
+    class IdleHandler {
+    public:
+        virtual ~IdleHandler() = default;
+
+        // Called when the message queue has run out of due messages. Return true to keep the idle handler active, false to have it removed.
+        virtual bool queueIdle() = 0;
+    };
+
+    ANDROID_EXPORT ~MessageQueue();
+
+    // Returns true if the looper has no pending messages which are due to be processed.
+    ANDROID_EXPORT bool isIdle();
+
+    // Add a new IdleHandler to this message queue. It may be removed by returning false from queueIdle().
+    ANDROID_EXPORT void addIdleHandler(IdleHandler* handler);
+    // Remove an IdleHandler from the queue that was previously added with addIdleHandler().
+    ANDROID_EXPORT void removeIdleHandler(IdleHandler* handler);
+
+    // Posts a synchronization barrier. Synchronous messages posted after it are held back until it is removed,
+    // while asynchronous ones keep being delivered. Returns a token which identifies the barrier.
+    ANDROID_EXPORT int32_t postSyncBarrier();
+    // Removes a synchronization barrier.
+    ANDROID_EXPORT void removeSyncBarrier(int32_t token);
+
+    // Adds a file descriptor listener to receive notification when file descriptor related events occur.
+    ANDROID_EXPORT void addOnFileDescriptorEventListener(int32_t fd, int32_t events, OnFileDescriptorEventListener* listener);
+    // Removes a file descriptor listener.
+    ANDROID_EXPORT void removeOnFileDescriptorEventListener(int32_t fd);
+
+private:
+    struct FileDescriptorRecord {
+        int32_t events;
+        OnFileDescriptorEventListener* listener;
+    };
+
+    struct SyncBarrier {
+        int32_t token;
+        std::chrono::nanoseconds fireTime;
+        int64_t sequence;
+    };
+
+    // The work of one priority. Asynchronous work is kept apart, since barriers don't hold it back.
+    struct Lane {
+        std::unique_ptr<WorkQueue> workQueue;
+        std::unique_ptr<WorkQueue> asynchronousWorkQueue;
+        // How many times in a row due work of this lane was passed over for work of a higher lane.
+        int32_t passedOver { 0 };
+    };
+
+    MessageQueue(int64_t tid);
+
+    // Creates a work item in the slab of this queue.
+    template<typename T, typename... P> std::unique_ptr<WorkItem> createWorkItem(P&&... arguments)
+    {
+        return std::unique_ptr<WorkItem>(new (*m_allocator) T(std::forward<P>(arguments)...));
+    }
+
+    bool enqueueWorkItem(std::unique_ptr<WorkItem>&&);
+    bool enqueueForeignWorkItem(std::unique_ptr<WorkItem>&&);
+    void drainIncomingWorkItems();
+    bool enqueueWorkItemAtFront(std::unique_ptr<WorkItem>&&);
+    // Lookups and removals go through one of the WorkItem::Index indexes, optionally narrowed down by a filter.
+    bool hasWorkItems(int32_t index, const WorkItemKey&, const std::function<bool (WorkItem&)>& filter = nullptr);
+    void removeWorkItems(int32_t index, const WorkItemKey&, const std::function<bool (WorkItem&)>& filter = nullptr);
+    void removeAllWorkItems(const std::function<bool (WorkItem&)>& filter);
+
+    void quit(bool safe);
+    void dispose();
+
+    // Returns the time base of the queue, which is SystemClock::steadyUptimeNanos() unless the queue runs on virtual
+    // time. Either way it doesn't depend on the clock of the calling thread.
+    std::chrono::nanoseconds uptimeNanos() const;
+    bool usesVirtualTime() const { return m_virtualUptime.load(std::memory_order_relaxed) >= 0; }
+    void useVirtualTime();
+    void advanceVirtualTime(std::chrono::nanoseconds);
+
+    WorkQueue& workQueueFor(const WorkItem&);
+    // Returns the queue of the lane whose top item fires next, taking barriers into account, or null if nothing can fire.
+    WorkQueue* nextWorkQueue(const Lane&);
+    // Returns the queue whose top item fires next in any lane.
+    WorkQueue* nextWorkQueue();
+    // Returns the queue holding the item to perform next among those due at currentTime, or at inputTime for the
+    // input lane, or null if none is due.
+    WorkQueue* nextDueWorkQueue(std::chrono::nanoseconds currentTime, std::chrono::nanoseconds inputTime);
+    size_t size() const;
+    void runIdleHandlers();
+
+    bool schedule();
+    void unscheduleIfEmpty();
+
+    void updateOnFileDescriptorEventListener(int32_t fd, int32_t events, OnFileDescriptorEventListener*);
+    void dispatchFileDescriptorEvents(int32_t fd, int32_t events);
+
+    bool platformWatchFileDescriptor(int32_t fd, int32_t events);
+    void platformUnwatchFileDescriptor(int32_t fd);
+
+    // MessageQueueProvider
+    void dispatchWorkItems();
+
+    int64_t m_tid;
+    std::unique_ptr<WorkItemAllocator> m_allocator;
+    std::unique_ptr<LooperMetrics> m_metrics;
+    std::unique_ptr<MessageQueueProvider> m_provider;
+    Lane m_lanes[Handler::PRIORITY_COUNT];
+    // Barriers are posted at the current time, so they are kept in the order they fire.
+    std::vector<SyncBarrier> m_syncBarriers;
+    int32_t m_nextBarrierToken { 0 };
+    std::vector<IdleHandler*> m_idleHandlers;
+    std::chrono::nanoseconds m_nextFireTime;
+    int64_t m_nextSequence { 0 };
+    int64_t m_nextFrontSequence { 0 };
+    std::atomic<bool> m_quitting { false };
+    // The clock of a queue running on virtual time, or -1.
+    std::atomic<int64_t> m_virtualUptime { -1 };
+    // Items posted from threads other than the looper thread, most recent first.
+    std::atomic<WorkItem*> m_incomingWorkItems { nullptr };
+    // Set while a wake up for incoming items is on its way, so that a burst of posts wakes the looper only once.
+    std::atomic<bool> m_wakeUpPending { false };
+    std::unordered_map<int32_t, FileDescriptorRecord> m_fileDescriptorRecords;
+};
+
+} // namespace os
+} // namespace android
+
+using MessageQueue = android::os::MessageQueue;
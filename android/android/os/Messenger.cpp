@@ -26,6 +26,7 @@
 #include "Messenger.h"
 
 #include "Handler.h"
+#include "Message.h"
 #include <android/os/MessageTarget.h>
 
 namespace android {
@@ -48,7 +49,12 @@ Messenger::~Messenger()
 
 void Messenger::send(Message& message)
 {
-    m_target->send(message);
+    m_target->send(Message(message));
+}
+
+void Messenger::send(Message&& message)
+{
+    m_target->send(std::move(message));
 }
 
 std::shared_ptr<IBinder> Messenger::getBinder()
@@ -45,6 +45,7 @@ public:
 
     // Send a Message to this Messenger's Handler.
     ANDROID_EXPORT void send(Message&);
+    ANDROID_EXPORT void send(Message&&);
 
     // Retrieve the IBinder that this Messenger is using to communicate with its associated Handler.
     ANDROID_EXPORT std::shared_ptr<IBinder> getBinder();
@@ -63,11 +63,29 @@ Parcel::~Parcel()
 {
 }
 
+Parcel Parcel::wrap(const int8_t* data, size_t length, std::function<void ()>&& release)
+{
+    Parcel parcel;
+    ParcelPrivate::initializeBorrowed(parcel, data, length, std::move(release));
+    return parcel;
+}
+
 int32_t Parcel::dataSize()
 {
     return m_private->size();
 }
 
+int32_t Parcel::dataCapacity()
+{
+    return m_private->capacity();
+}
+
+void Parcel::setDataCapacity(int32_t size)
+{
+    if (size > 0)
+        m_private->reserve(static_cast<size_t>(size));
+}
+
 int8_t* Parcel::data()
 {
     return m_private->data();
@@ -221,5 +239,96 @@ Parcel& Parcel::operator>>(std::shared_ptr<Parcelable>& value)
     return *this;
 }
 
+void Parcel::writeByteArray(const std::vector<int8_t>& value)
+{
+    writeArray(value.data(), value.size(), sizeof(int8_t));
+}
+
+void Parcel::writeIntArray(const std::vector<int32_t>& value)
+{
+    writeArray(value.data(), value.size(), sizeof(int32_t));
+}
+
+void Parcel::writeLongArray(const std::vector<int64_t>& value)
+{
+    writeArray(value.data(), value.size(), sizeof(int64_t));
+}
+
+void Parcel::writeFloatArray(const std::vector<float>& value)
+{
+    writeArray(value.data(), value.size(), sizeof(float));
+}
+
+void Parcel::writeDoubleArray(const std::vector<double>& value)
+{
+    writeArray(value.data(), value.size(), sizeof(double));
+}
+
+void Parcel::writeStringArray(const std::vector<String>& value)
+{
+    *this << value.size();
+    for (auto& string : value)
+        *this << string;
+}
+
+template<typename T> static std::vector<T> createArray(Parcel& parcel)
+{
+    Parcel::ArrayRef<T> span = parcel.readSpan<T>();
+    return std::vector<T>(span.begin(), span.end());
+}
+
+std::vector<int8_t> Parcel::createByteArray()
+{
+    return createArray<int8_t>(*this);
+}
+
+std::vector<int32_t> Parcel::createIntArray()
+{
+    return createArray<int32_t>(*this);
+}
+
+std::vector<int64_t> Parcel::createLongArray()
+{
+    return createArray<int64_t>(*this);
+}
+
+std::vector<float> Parcel::createFloatArray()
+{
+    return createArray<float>(*this);
+}
+
+std::vector<double> Parcel::createDoubleArray()
+{
+    return createArray<double>(*this);
+}
+
+std::vector<String> Parcel::createStringArray()
+{
+    size_t length = 0;
+    *this >> length;
+    // Every string takes at least the bytes of its length, which tells a corrupt count apart.
+    std::vector<String> value;
+    if (length > m_private->size() / sizeof(size_t))
+        return value;
+
+    value.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        String string;
+        *this >> string;
+        value.push_back(std::move(string));
+    }
+    return value;
+}
+
+void Parcel::writeArray(const void* data, size_t length, size_t elementSize)
+{
+    m_private->writeArray(data, length, elementSize);
+}
+
+const int8_t* Parcel::readArray(size_t& length, size_t elementSize)
+{
+    return m_private->readArray(length, elementSize);
+}
+
 } // namespace os
 } // namespace android
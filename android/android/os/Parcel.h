@@ -27,6 +27,9 @@
 
 #include <java/lang.h>
 
+#include <functional>
+#include <vector>
+
 namespace android {
 namespace os {
 
@@ -36,6 +39,27 @@ class Parcelable;
 class Parcel final {
     friend class ParcelPrivate;
 public:
+    // A run of values read in place. It points into the parcel, so it is only valid until the parcel is written to or destroyed.
+    template<typename T> class ArrayRef {
+    public:
+        ArrayRef() = default;
+        ArrayRef(const T* data, size_t size) : m_data(data), m_size(size) { }
+
+        const T* data() const { return m_data; }
+        size_t size() const { return m_size; }
+        bool empty() const { return !m_size; }
+        const T* begin() const { return m_data; }
+        const T* end() const { return m_data + m_size; }
+        const T& operator[](size_t index) const { return m_data[index]; }
+#if defined(__cpp_lib_string_view)
+        operator std::basic_string_view<T>() const { return std::basic_string_view<T>(m_data, m_size); }
+#endif
+
+    private:
+        const T* m_data { nullptr };
+        size_t m_size { 0 };
+    };
+
     ANDROID_EXPORT Parcel();
     ANDROID_EXPORT Parcel(const Parcel&);
     ANDROID_EXPORT Parcel(Parcel&&);
@@ -43,8 +67,17 @@ public:
     ANDROID_EXPORT Parcel& operator=(Parcel&&);
     ANDROID_EXPORT ~Parcel();
 
+    // Returns a parcel which reads data owned elsewhere, such as a shared memory region or a mapped file, without copying it.
+    // release is invoked once the parcel no longer refers to the data. Writing to the parcel copies the data first,
+    // as does data which isn't aligned for std::max_align_t, since arrays are read from it in place.
+    ANDROID_EXPORT static Parcel wrap(const int8_t* data, size_t length, std::function<void ()>&& release);
+
     // Returns the total amount of data contained in the parcel. 
     ANDROID_EXPORT int32_t dataSize();
+    // Returns the total amount of space in the parcel.
+    ANDROID_EXPORT int32_t dataCapacity();
+    // Change the capacity (current available space) of the parcel. Writing up to size bytes then doesn't reallocate.
+    ANDROID_EXPORT void setDataCapacity(int32_t size);
 
     ANDROID_EXPORT int8_t* data();
 
@@ -59,6 +92,12 @@ public:
     ANDROID_EXPORT Parcel& operator<<(const std::string&);
     ANDROID_EXPORT Parcel& operator<<(const CharSequence&);
     ANDROID_EXPORT Parcel& operator<<(const Parcelable&);
+    template<typename T> Parcel& operator<<(ArrayRef<T> value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Arrays are written as raw bytes");
+        writeArray(value.data(), value.size(), sizeof(T));
+        return *this;
+    }
 
     ANDROID_EXPORT Parcel& operator>>(bool&);
     ANDROID_EXPORT Parcel& operator>>(wchar_t&);
@@ -72,8 +111,42 @@ public:
     ANDROID_EXPORT Parcel& operator>>(std::string&);
     ANDROID_EXPORT Parcel& operator>>(CharSequence&);
     ANDROID_EXPORT Parcel& operator>>(std::shared_ptr<Parcelable>&);
+    // Reads an array in place, including the characters of a std::string or a CharSequence, without copying them.
+    template<typename T> Parcel& operator>>(ArrayRef<T>& value)
+    {
+        value = readSpan<T>();
+        return *this;
+    }
+
+    // Arrays are written as their length followed by the elements, with a single bounds check and copy.
+    ANDROID_EXPORT void writeByteArray(const std::vector<int8_t>&);
+    ANDROID_EXPORT void writeIntArray(const std::vector<int32_t>&);
+    ANDROID_EXPORT void writeLongArray(const std::vector<int64_t>&);
+    ANDROID_EXPORT void writeFloatArray(const std::vector<float>&);
+    ANDROID_EXPORT void writeDoubleArray(const std::vector<double>&);
+    ANDROID_EXPORT void writeStringArray(const std::vector<String>&);
+
+    // Read arrays written by the matching write methods. An array whose length doesn't fit the data comes back empty.
+    ANDROID_EXPORT std::vector<int8_t> createByteArray();
+    ANDROID_EXPORT std::vector<int32_t> createIntArray();
+    ANDROID_EXPORT std::vector<int64_t> createLongArray();
+    ANDROID_EXPORT std::vector<float> createFloatArray();
+    ANDROID_EXPORT std::vector<double> createDoubleArray();
+    ANDROID_EXPORT std::vector<String> createStringArray();
+
+    // Reads an array written by one of the write methods in place, without copying it.
+    template<typename T> ArrayRef<T> readSpan()
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Arrays are read as raw bytes");
+        size_t length = 0;
+        const int8_t* data = readArray(length, sizeof(T));
+        return data ? ArrayRef<T>(reinterpret_cast<const T*>(data), length) : ArrayRef<T>();
+    }
 
 private:
+    ANDROID_EXPORT void writeArray(const void* data, size_t length, size_t elementSize);
+    ANDROID_EXPORT const int8_t* readArray(size_t& length, size_t elementSize);
+
     std::shared_ptr<ParcelPrivate> m_private;
 };
 
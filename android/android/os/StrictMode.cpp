@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "StrictMode.h"
+
+#include <android/os/SystemClock.h>
+#include <android++/LogHelper.h>
+#include <android++/TemporaryChange.h>
+
+#include <atomic>
+#include <cstdlib>
+
+namespace android {
+namespace os {
+
+static const int32_t PENALTY_LOG = 1 << 0;
+static const int32_t PENALTY_COUNT = 1 << 1;
+static const int32_t PENALTY_DEATH = 1 << 2;
+
+static const int32_t DETECT_ALL = StrictMode::DISK_READ | StrictMode::DISK_WRITE | StrictMode::BLOCKING_TRANSACTION | StrictMode::LOCK_WAIT;
+static const int32_t violationTypeCount = 4;
+
+static std::atomic<int64_t> violationCounts[violationTypeCount];
+
+static thread_local StrictMode::ThreadPolicy threadPolicy;
+// Set while a violation is reported, so that blocking in the penalties isn't reported in turn.
+static thread_local bool threadReporting = false;
+
+static int32_t violationIndex(StrictMode::ViolationType type)
+{
+    int32_t index = 0;
+    while (!(type & (1 << index)))
+        ++index;
+    return index;
+}
+
+static const char* violationName(StrictMode::ViolationType type)
+{
+    switch (type) {
+    case StrictMode::DISK_READ:
+        return "Disk read";
+    case StrictMode::DISK_WRITE:
+        return "Disk write";
+    case StrictMode::BLOCKING_TRANSACTION:
+        return "Blocking transaction";
+    case StrictMode::LOCK_WAIT:
+        return "Lock wait";
+    }
+    return "Unknown violation";
+}
+
+const StrictMode::ThreadPolicy StrictMode::ThreadPolicy::LAX;
+
+StrictMode::ThreadPolicy::Builder::Builder()
+    : Builder(LAX)
+{
+}
+
+StrictMode::ThreadPolicy::Builder::Builder(const ThreadPolicy& policy)
+    : m_detect(policy.m_detect)
+    , m_penalty(policy.m_penalty)
+    , m_lockWaitThreshold(policy.m_lockWaitThreshold)
+    , m_listener(policy.m_listener)
+{
+}
+
+StrictMode::ThreadPolicy::Builder& StrictMode::ThreadPolicy::Builder::detectAll()
+{
+    if (!(m_detect & LOCK_WAIT))
+        detectLockWaits();
+    m_detect |= DETECT_ALL;
+    return *this;
+}
+
+StrictMode::ThreadPolicy::Builder& StrictMode::ThreadPolicy::Builder::detectDiskReads()
+{
+    m_detect |= DISK_READ;
+    return *this;
+}
+
+StrictMode::ThreadPolicy::Builder& StrictMode::ThreadPolicy::Builder::detectDiskWrites()
+{
+    m_detect |= DISK_WRITE;
+    return *this;
+}
+
+StrictMode::ThreadPolicy::Builder& StrictMode::ThreadPolicy::Builder::detectBlockingTransactions()
+{
+    m_detect |= BLOCKING_TRANSACTION;
+    return *this;
+}
+
+StrictMode::ThreadPolicy::Builder& StrictMode::ThreadPolicy::Builder::detectLockWaits(std::chrono::milliseconds threshold)
+{
+    m_detect |= LOCK_WAIT;
+    m_lockWaitThreshold = threshold;
+    return *this;
+}
+
+StrictMode::ThreadPolicy::Builder& StrictMode::ThreadPolicy::Builder::permitAll()
+{
+    m_detect = 0;
+    return *this;
+}
+
+StrictMode::ThreadPolicy::Builder& StrictMode::ThreadPolicy::Builder::penaltyLog()
+{
+    m_penalty |= PENALTY_LOG;
+    return *this;
+}
+
+StrictMode::ThreadPolicy::Builder& StrictMode::ThreadPolicy::Builder::penaltyCount()
+{
+    m_penalty |= PENALTY_COUNT;
+    return *this;
+}
+
+StrictMode::ThreadPolicy::Builder& StrictMode::ThreadPolicy::Builder::penaltyDeath()
+{
+    m_penalty |= PENALTY_DEATH;
+    return *this;
+}
+
+StrictMode::ThreadPolicy::Builder& StrictMode::ThreadPolicy::Builder::penaltyListener(listener_t&& listener)
+{
+    m_listener = std::move(listener);
+    return *this;
+}
+
+StrictMode::ThreadPolicy StrictMode::ThreadPolicy::Builder::build()
+{
+    // Like the platform, a policy which detects something without any penalty logs it.
+    ThreadPolicy policy;
+    policy.m_detect = m_detect;
+    policy.m_penalty = m_penalty || m_listener ? m_penalty : PENALTY_LOG;
+    policy.m_lockWaitThreshold = m_lockWaitThreshold;
+    policy.m_listener = m_listener;
+    return policy;
+}
+
+StrictMode::BlockingCall::BlockingCall(ViolationType type, const char* callSite)
+    : m_type(type)
+    , m_callSite(callSite)
+    , m_detecting((threadPolicy.m_detect & type) && !threadReporting)
+{
+    if (m_detecting)
+        m_startTime = SystemClock::uptimeNanos();
+}
+
+StrictMode::BlockingCall::~BlockingCall()
+{
+    if (!m_detecting)
+        return;
+
+    std::chrono::nanoseconds duration = SystemClock::uptimeNanos() - m_startTime;
+    if (m_type == LOCK_WAIT && duration < threadPolicy.m_lockWaitThreshold)
+        return;
+
+    Violation violation = { m_type, m_callSite, duration, {} };
+    onViolation(threadPolicy, violation);
+}
+
+void StrictMode::setThreadPolicy(const ThreadPolicy& policy)
+{
+    threadPolicy = policy;
+}
+
+StrictMode::ThreadPolicy StrictMode::getThreadPolicy()
+{
+    return threadPolicy;
+}
+
+int64_t StrictMode::getViolationCount(ViolationType type)
+{
+    return violationCounts[violationIndex(type)].load(std::memory_order_relaxed);
+}
+
+void StrictMode::onViolation(const ThreadPolicy& currentPolicy, Violation& violation)
+{
+    TemporaryChange<bool> reportingChange(threadReporting, true);
+    // The listener may well change the policy of the thread.
+    ThreadPolicy policy = currentPolicy;
+
+    platformCaptureStack(violation.stack);
+
+    if (policy.m_penalty & PENALTY_COUNT)
+        violationCounts[violationIndex(violation.type)].fetch_add(1, std::memory_order_relaxed);
+
+    if (policy.m_penalty & (PENALTY_LOG | PENALTY_DEATH)) {
+        LOGW("StrictMode policy violation: %s in %s took %lldms", violationName(violation.type), violation.callSite,
+            static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(violation.duration).count()));
+        for (size_t i = 0; i < violation.stack.size(); ++i)
+            LOGW("  #%02d %s", static_cast<int32_t>(i), violation.stack[i].c_str());
+    }
+
+    if (policy.m_listener)
+        policy.m_listener(violation);
+
+    if (policy.m_penalty & PENALTY_DEATH) {
+        LOGA("%s", "StrictMode policy violation with penaltyDeath");
+        std::abort();
+    }
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <java/lang.h>
+
+#include <functional>
+#include <vector>
+
+namespace android {
+namespace os {
+
+// Detects blocking operations on threads which shouldn't block, such as the UI looper thread. Policies are set per
+// thread, and the operations report themselves through BlockingCall.
+class StrictMode final {
+public:
+    // Kinds of blocking operations a thread policy can detect.
+    enum ViolationType {
+        DISK_READ = 1 << 0,
+        DISK_WRITE = 1 << 1,
+        // A binder transaction, which blocks until it is delivered, or replied to unless it is one way.
+        BLOCKING_TRANSACTION = 1 << 2,
+        // Waiting for a contended lock for longer than the threshold of the policy.
+        LOCK_WAIT = 1 << 3,
+    };
+
+    // What is known about a detected operation.
+    struct Violation {
+        ViolationType type;
+        const char* callSite;
+        std::chrono::nanoseconds duration;
+        // Frames of the stack of the blocking thread, innermost first.
+        std::vector<std::string> stack;
+    };
+
+    typedef std::function<void (const Violation&)> listener_t;
+
+    class ThreadPolicy final {
+        friend class StrictMode;
+    public:
+        class Builder final {
+        public:
+            ANDROID_EXPORT Builder();
+            ANDROID_EXPORT Builder(const ThreadPolicy& policy);
+
+            // Detect everything that is potentially suspect.
+            ANDROID_EXPORT Builder& detectAll();
+            ANDROID_EXPORT Builder& detectDiskReads();
+            ANDROID_EXPORT Builder& detectDiskWrites();
+            // Detect binder transactions, which block the thread until the other side receives or answers them.
+            ANDROID_EXPORT Builder& detectBlockingTransactions();
+            // Detect waits for contended locks which last longer than threshold.
+            ANDROID_EXPORT Builder& detectLockWaits(std::chrono::milliseconds threshold = std::chrono::milliseconds(16));
+            // Disable the detection of everything.
+            ANDROID_EXPORT Builder& permitAll();
+
+            // Log detected violations to the system log, with their call site, duration and stack.
+            ANDROID_EXPORT Builder& penaltyLog();
+            // Count detected violations, see getViolationCount().
+            ANDROID_EXPORT Builder& penaltyCount();
+            // Crash the whole process on violation.
+            ANDROID_EXPORT Builder& penaltyDeath();
+            // Call the listener on violation, on the thread which violated the policy.
+            ANDROID_EXPORT Builder& penaltyListener(listener_t&& listener);
+
+            ANDROID_EXPORT ThreadPolicy build();
+
+        private:
+            int32_t m_detect;
+            int32_t m_penalty;
+            std::chrono::milliseconds m_lockWaitThreshold;
+            listener_t m_listener;
+        };
+
+        // The default, lax policy which doesn't catch anything.
+        ANDROID_EXPORT static const ThreadPolicy LAX;
+
+    private:
+        int32_t m_detect { 0 };
+        int32_t m_penalty { 0 };
+        std::chrono::milliseconds m_lockWaitThreshold { 0 };
+        listener_t m_listener;
+    };
+
+    // Marks a blocking operation of the current thread, from construction to destruction. Costs a thread local load
+    // unless the policy of the thread detects that kind of operation.
+    class BlockingCall final {
+        NONCOPYABLE(BlockingCall);
+    public:
+        ANDROID_EXPORT BlockingCall(ViolationType type, const char* callSite);
+        ANDROID_EXPORT ~BlockingCall();
+
+    private:
+        ViolationType m_type;
+        const char* m_callSite;
+        std::chrono::nanoseconds m_startTime { 0 };
+        bool m_detecting;
+    };
+
+    // Sets the policy for what actions on the current thread should be detected, as well as the penalty if such actions occur.
+    ANDROID_EXPORT static void setThreadPolicy(const ThreadPolicy& policy);
+    // Returns the current thread's policy.
+    ANDROID_EXPORT static ThreadPolicy getThreadPolicy();
+    // Returns how many violations of the given type policies with penaltyCount() have detected in the whole process.
+    ANDROID_EXPORT static int64_t getViolationCount(ViolationType type);
+
+private:
+    static void onViolation(const ThreadPolicy&, Violation&);
+
+    // Fills in the frames of the current thread's stack, innermost first.
+    static void platformCaptureStack(std::vector<std::string>& frames);
+};
+
+} // namespace os
+} // namespace android
+
+using StrictMode = android::os::StrictMode;
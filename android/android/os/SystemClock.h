@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <java/lang.h>
+
+#include <atomic>
+#include <thread>
+
+namespace android {
+namespace os {
+
+// Core timekeeping facilities. Unlike System::currentTimeMillis(), these clocks are monotonic: they are never set
+// and don't jump when the wall clock is changed, so they are the basis for scheduling Handler messages.
+// Both uptime and elapsed realtime count from the epoch of std::chrono::steady_clock, except on a thread whose
+// looper runs on virtual time (see Looper::prepareVirtualTime()), where they report the clock of that looper.
+class SystemClock {
+    friend class MessageQueue;
+public:
+    // Returns milliseconds since boot, not counting time spent in deep sleep.
+    static std::chrono::milliseconds uptimeMillis()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(uptimeNanos());
+    }
+    // Returns nanoseconds since boot, not counting time spent in deep sleep.
+    static std::chrono::nanoseconds uptimeNanos()
+    {
+        if (std::atomic<int64_t>* virtualUptime = threadVirtualUptime())
+            return std::chrono::nanoseconds(virtualUptime->load(std::memory_order_relaxed));
+        return steadyUptimeNanos();
+    }
+    // Returns nanoseconds since boot of the real clock, even on a thread running on virtual time. Anything which
+    // schedules against loopers that don't run on virtual time must use this, whichever thread it is called on.
+    static std::chrono::nanoseconds steadyUptimeNanos()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+    }
+    // Returns milliseconds since boot, including time spent in sleep.
+    static std::chrono::milliseconds elapsedRealtime()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(elapsedRealtimeNanos());
+    }
+    // Returns nanoseconds since boot, including time spent in sleep.
+    static std::chrono::nanoseconds elapsedRealtimeNanos()
+    {
+        return uptimeNanos();
+    }
+
+    // Waits a given number of milliseconds (of uptimeMillis) before returning. On virtual time, the clock is moved
+    // forward instead.
+    static void sleep(std::chrono::milliseconds ms)
+    {
+        if (std::atomic<int64_t>* virtualUptime = threadVirtualUptime()) {
+            virtualUptime->fetch_add(std::chrono::nanoseconds(ms).count(), std::memory_order_relaxed);
+            return;
+        }
+        std::this_thread::sleep_for(ms);
+    }
+
+private:
+    SystemClock() = default;
+
+    // The clock of the current thread if its looper runs on virtual time, or null.
+    ANDROID_EXPORT static std::atomic<int64_t>*& threadVirtualUptime();
+};
+
+} // namespace os
+} // namespace android
+
+using SystemClock = android::os::SystemClock;
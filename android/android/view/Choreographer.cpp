@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Choreographer.h"
+
+#include <android/os/Handler.h>
+#include <android/os/Looper.h>
+#include <android/os/SystemClock.h>
+#include <android/view/DisplayEventReceiver.h>
+#include <android++/LogHelper.h>
+
+#include <algorithm>
+
+namespace android {
+namespace view {
+
+static thread_local std::unique_ptr<Choreographer> threadChoreographer;
+
+Choreographer::Choreographer(os::Looper* looper)
+    : m_handler(std::make_unique<os::Handler>(looper, true, os::Handler::PRIORITY_ANIMATION))
+    , m_displayEventReceiver(std::make_unique<DisplayEventReceiver>(looper, [this] (std::chrono::nanoseconds frameTimeNanos) {
+        doFrame(frameTimeNanos);
+    }))
+    , m_lastFrameTimeNanos(std::chrono::nanoseconds::zero())
+    , m_frameIntervalNanos(m_displayEventReceiver->vsyncInterval())
+{
+}
+
+Choreographer::~Choreographer()
+{
+}
+
+Choreographer& Choreographer::getInstance()
+{
+    if (!threadChoreographer) {
+        Looper* looper = Looper::myLooper();
+        if (!looper) {
+            LOGA("The current thread must have a looper!");
+            assert(false);
+        }
+        threadChoreographer.reset(new Choreographer(looper));
+    }
+
+    return *threadChoreographer;
+}
+
+std::chrono::nanoseconds Choreographer::getFrameTimeNanos()
+{
+    synchronized (this) {
+        return m_lastFrameTimeNanos;
+    }
+    return std::chrono::nanoseconds::zero();
+}
+
+std::chrono::nanoseconds Choreographer::getFrameIntervalNanos()
+{
+    return m_frameIntervalNanos;
+}
+
+void Choreographer::postCallback(int32_t callbackType, std::function<void ()>&& action, const void* token)
+{
+    postCallbackDelayed(callbackType, std::move(action), token, std::chrono::milliseconds::zero());
+}
+
+void Choreographer::postCallbackDelayed(int32_t callbackType, std::function<void ()>&& action, const void* token, std::chrono::milliseconds delayMillis)
+{
+    assert(action);
+    postCallbackRecord(callbackType, { SystemClock::uptimeNanos() + delayMillis, std::move(action), nullptr, token });
+}
+
+void Choreographer::removeCallbacks(int32_t callbackType, const void* token)
+{
+    removeCallbackRecords(callbackType, [=] (const CallbackRecord& record) {
+        return !record.frameCallback && (!token || record.token == token);
+    });
+}
+
+void Choreographer::postFrameCallback(FrameCallback* callback)
+{
+    postFrameCallbackDelayed(callback, std::chrono::milliseconds::zero());
+}
+
+void Choreographer::postFrameCallbackDelayed(FrameCallback* callback, std::chrono::milliseconds delayMillis)
+{
+    assert(callback);
+    postCallbackRecord(CALLBACK_ANIMATION, { SystemClock::uptimeNanos() + delayMillis, nullptr, callback, callback });
+}
+
+void Choreographer::removeFrameCallback(FrameCallback* callback)
+{
+    removeCallbackRecords(CALLBACK_ANIMATION, [=] (const CallbackRecord& record) {
+        return record.frameCallback == callback;
+    });
+}
+
+void Choreographer::postCallbackRecord(int32_t callbackType, CallbackRecord&& record)
+{
+    assert(callbackType >= 0 && callbackType <= CALLBACK_LAST);
+
+    std::chrono::nanoseconds now = SystemClock::uptimeNanos();
+    std::chrono::nanoseconds dueTime = record.dueTime;
+    synchronized (this) {
+        m_callbackQueues[callbackType].push_back(std::move(record));
+
+        if (dueTime <= now) {
+            scheduleFrameLocked();
+            return;
+        }
+    }
+
+    // Delayed callbacks only ask for a frame once they are due.
+    m_handler->postAtTime([this] {
+        synchronized (this) {
+            scheduleFrameLocked();
+        }
+    }, this, dueTime);
+}
+
+void Choreographer::removeCallbackRecords(int32_t callbackType, const std::function<bool (const CallbackRecord&)>& match)
+{
+    assert(callbackType >= 0 && callbackType <= CALLBACK_LAST);
+
+    // Actions are released outside of the lock, since they may capture objects which post again.
+    std::vector<CallbackRecord> removedRecords;
+    synchronized (this) {
+        std::vector<CallbackRecord>& records = m_callbackQueues[callbackType];
+        auto removed = std::stable_partition(records.begin(), records.end(), [&] (const CallbackRecord& record) {
+            return !match(record);
+        });
+        std::move(removed, records.end(), std::back_inserter(removedRecords));
+        records.erase(removed, records.end());
+    }
+}
+
+void Choreographer::scheduleFrameLocked()
+{
+    if (m_frameScheduled)
+        return;
+
+    m_frameScheduled = true;
+    m_displayEventReceiver->scheduleVsync();
+}
+
+void Choreographer::doFrame(std::chrono::nanoseconds frameTimeNanos)
+{
+    synchronized (this) {
+        if (!m_frameScheduled)
+            return;
+
+        // If the looper was busy for longer than a frame, skip the missed frames and act as if this one started at
+        // the most recent vsync, so animations don't try to catch up.
+        std::chrono::nanoseconds startNanos = SystemClock::uptimeNanos();
+        std::chrono::nanoseconds jitterNanos = startNanos - frameTimeNanos;
+        if (jitterNanos >= m_frameIntervalNanos)
+            frameTimeNanos = startNanos - jitterNanos % m_frameIntervalNanos;
+
+        if (frameTimeNanos < m_lastFrameTimeNanos) {
+            m_displayEventReceiver->scheduleVsync();
+            return;
+        }
+
+        m_frameScheduled = false;
+        m_lastFrameTimeNanos = frameTimeNanos;
+    }
+
+    doCallbacks(CALLBACK_INPUT, frameTimeNanos);
+    doCallbacks(CALLBACK_ANIMATION, frameTimeNanos);
+    doCallbacks(CALLBACK_TRAVERSAL, frameTimeNanos);
+}
+
+void Choreographer::doCallbacks(int32_t callbackType, std::chrono::nanoseconds frameTimeNanos)
+{
+    // Callbacks posted while this runs belong to the next frame.
+    std::vector<CallbackRecord> dueRecords;
+    std::chrono::nanoseconds now = SystemClock::uptimeNanos();
+    synchronized (this) {
+        std::vector<CallbackRecord>& records = m_callbackQueues[callbackType];
+        auto pending = std::stable_partition(records.begin(), records.end(), [=] (const CallbackRecord& record) {
+            return record.dueTime <= now;
+        });
+        std::move(records.begin(), pending, std::back_inserter(dueRecords));
+        records.erase(records.begin(), pending);
+    }
+
+    for (auto& record : dueRecords) {
+        if (record.frameCallback)
+            record.frameCallback->doFrame(frameTimeNanos);
+        else
+            record.action();
+    }
+}
+
+} // namespace view
+} // namespace android
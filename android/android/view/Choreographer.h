@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <java/lang.h>
+
+#include <vector>
+
+namespace android {
+namespace os {
+class Handler;
+class Looper;
+}
+namespace view {
+
+class DisplayEventReceiver;
+
+// Coordinates the timing of animations, input and drawing. Work posted to it runs in one pass per frame, at the
+// next vsync of the display.
+class Choreographer final : public Object {
+    NONCOPYABLE(Choreographer);
+public:
+    // Callback type: Input callback. Runs first.
+    static const int32_t CALLBACK_INPUT = 0;
+    // Callback type: Animation callback. Runs before traversals.
+    static const int32_t CALLBACK_ANIMATION = 1;
+    // Callback type: Traversal callback. Handles layout and draw. Runs after all other asynchronous messages have been handled.
+    static const int32_t CALLBACK_TRAVERSAL = 2;
+
+    // Implement this interface to receive a callback when a new display frame is being rendered.
+    class FrameCallback {
+    public:
+        virtual ~FrameCallback() = default;
+
+        // Called when a new display frame is being rendered. frameTimeNanos is the vsync time in the SystemClock::uptimeNanos() time base.
+        virtual void doFrame(std::chrono::nanoseconds frameTimeNanos) = 0;
+    };
+
+    ANDROID_EXPORT ~Choreographer();
+
+    // Gets the choreographer for the calling thread. The thread must have a looper.
+    ANDROID_EXPORT static Choreographer& getInstance();
+
+    // Gets the time when the current frame started, in the SystemClock::uptimeNanos() time base.
+    ANDROID_EXPORT std::chrono::nanoseconds getFrameTimeNanos();
+    // Gets the time between two display frames.
+    ANDROID_EXPORT std::chrono::nanoseconds getFrameIntervalNanos();
+
+    // Posts a callback to run on the next frame.
+    ANDROID_EXPORT void postCallback(int32_t callbackType, std::function<void ()>&& action, const void* token = nullptr);
+    // Posts a callback to run on the next frame after the specified delay.
+    ANDROID_EXPORT void postCallbackDelayed(int32_t callbackType, std::function<void ()>&& action, const void* token, std::chrono::milliseconds delayMillis);
+    // Removes callbacks of the given type that were posted with token. If token is null, all callbacks of that type are removed.
+    ANDROID_EXPORT void removeCallbacks(int32_t callbackType, const void* token);
+
+    // Posts a frame callback to run on the next frame.
+    ANDROID_EXPORT void postFrameCallback(FrameCallback* callback);
+    // Posts a frame callback to run on the next frame after the specified delay.
+    ANDROID_EXPORT void postFrameCallbackDelayed(FrameCallback* callback, std::chrono::milliseconds delayMillis);
+    // Removes a previously posted frame callback.
+    ANDROID_EXPORT void removeFrameCallback(FrameCallback* callback);
+
+private:
+    static const int32_t CALLBACK_LAST = CALLBACK_TRAVERSAL;
+
+    struct CallbackRecord {
+        std::chrono::nanoseconds dueTime;
+        std::function<void ()> action;
+        FrameCallback* frameCallback;
+        const void* token;
+    };
+
+    Choreographer(os::Looper*);
+
+    void postCallbackRecord(int32_t callbackType, CallbackRecord&&);
+    void removeCallbackRecords(int32_t callbackType, const std::function<bool (const CallbackRecord&)>& match);
+    void scheduleFrameLocked();
+    void doFrame(std::chrono::nanoseconds frameTimeNanos);
+    void doCallbacks(int32_t callbackType, std::chrono::nanoseconds frameTimeNanos);
+
+    // Asynchronous, so frames aren't held back by synchronization barriers.
+    std::unique_ptr<os::Handler> m_handler;
+    std::unique_ptr<DisplayEventReceiver> m_displayEventReceiver;
+    std::vector<CallbackRecord> m_callbackQueues[CALLBACK_LAST + 1];
+    bool m_frameScheduled { false };
+    std::chrono::nanoseconds m_lastFrameTimeNanos;
+    std::chrono::nanoseconds m_frameIntervalNanos;
+};
+
+} // namespace view
+} // namespace android
+
+using Choreographer = android::view::Choreographer;
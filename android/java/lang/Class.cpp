@@ -32,6 +32,7 @@ Class::Class(ClassLoader& classLoader, String&& packageName, String&& name, std:
     : m_classLoader(classLoader)
     , m_package(*classLoader.getPackage(packageName))
     , m_name(std::move(name))
+    , m_binaryName(m_package.getName() + L'.' + m_name)
     , m_constructor(std::move(constructor))
 {
 }
@@ -55,9 +56,9 @@ Package& Class::getPackage()
     return m_package;
 }
 
-String Class::getName()
+StringRef Class::getName()
 {
-    return m_package.getName() + L'.' + m_name;
+    return m_binaryName;
 }
 
 StringRef Class::getSimpleName()
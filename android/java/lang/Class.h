@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <android++/Assertions.h>
 #include <java/lang/Package.h>
 
 namespace java {
@@ -43,7 +44,7 @@ public:
     // Gets the package for this class. 
     ANDROID_EXPORT virtual Package& getPackage();
     // Returns the name of the entity (class, interface, array class, primitive type, or void) represented by this Class object, as a String.
-    ANDROID_EXPORT virtual String getName();
+    ANDROID_EXPORT virtual StringRef getName();
     // Returns the simple name of the underlying class as given in the source code. 
     ANDROID_EXPORT virtual StringRef getSimpleName();
     // Creates a new instance of the class represented by this Class object. 
@@ -55,6 +56,8 @@ protected:
     ClassLoader& m_classLoader;
     Package& m_package;
     String m_name;
+    // The binary name is put together once, as classes are looked up by it.
+    String m_binaryName;
     std::function<std::shared_ptr<void> ()> m_constructor;
 };
 
@@ -69,6 +72,11 @@ public:
         : Class(classLoader, std::move(packageName), std::move(name), [] { return std::make_shared<T>(); })
     {
     }
+    // For classes whose instances are created some other way, such as singletons.
+    ClassT(String&& packageName, String&& name, std::function<std::shared_ptr<void> ()>&& constructor)
+        : Class(ClassLoader::getSystemClassLoader(), std::move(packageName), std::move(name), std::move(constructor))
+    {
+    }
 };
 
 } // namespace lang
@@ -79,13 +87,14 @@ using Class = java::lang::Class;
 template<typename T>
 Class& classT(const wchar_t* packageName = nullptr, const wchar_t* name = nullptr)
 {
-    static String binaryName;
+    static Class* resolvedClass = nullptr;
     if (packageName && name) {
-        assert(binaryName.empty());
+        assert(!resolvedClass);
         ClassLoader::getSystemClassLoader().definePackage(String(packageName), String(), String(), String(), String(), String(), String(), URL());
-        ClassLoader::getSystemClassLoader().resolveClass(std::make_shared<java::lang::ClassT<T>>(String(packageName), String(name)));
-        binaryName = String(packageName) + L'.' + String(name);
+        auto newClass = std::make_shared<java::lang::ClassT<T>>(String(packageName), String(name));
+        ClassLoader::getSystemClassLoader().resolveClass(newClass);
+        resolvedClass = ClassLoader::getSystemClassLoader().findClass(newClass->getName()).get();
     }
 
-    return *ClassLoader::getSystemClassLoader().findClass(binaryName);
+    return *resolvedClass;
 }
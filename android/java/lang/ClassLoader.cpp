@@ -45,7 +45,7 @@ ClassLoader& ClassLoader::getSystemClassLoader()
     return *loader;
 }
 
-std::passed_ptr<Package> ClassLoader::definePackage(StringRef name, StringRef specTitle, StringRef specVersion, StringRef specVendor, StringRef implTitle, StringRef implVersion, StringRef implVendor, URL& sealBase)
+std::passed_ptr<Package> ClassLoader::definePackage(StringRef name, StringRef specTitle, StringRef specVersion, StringRef specVendor, StringRef implTitle, StringRef implVersion, StringRef implVendor, const URL& sealBase)
 {
     if (m_packages.count(name))
         return getPackage(name);
@@ -63,18 +63,14 @@ std::passed_ptr<Package> ClassLoader::getPackage(StringRef name)
 
 std::passed_ptr<Class> ClassLoader::findClass(StringRef name)
 {
-    if (!m_classes.count(name))
-        return nullptr;
-
-    return m_classes[name];
+    static const std::shared_ptr<Class> notFound;
+    auto found = m_classes.find(name);
+    return found != m_classes.end() ? found->second : notFound;
 }
 
 void ClassLoader::resolveClass(std::passed_ptr<Class> c)
 {
-    if (m_classes.count(c->getName()))
-        return;
-
-    m_classes[c->getName()] = c;
+    m_classes.emplace(c->getName(), c);
 }
 
 } // namespace lang
@@ -49,7 +49,7 @@ public:
     // Returns the system class loader for delegation.
     ANDROID_EXPORT static ClassLoader& getSystemClassLoader();
     // Defines a package by name in this ClassLoader. 
-    ANDROID_EXPORT virtual std::passed_ptr<Package> definePackage(StringRef name, StringRef specTitle, StringRef specVersion, StringRef specVendor, StringRef implTitle, StringRef implVersion, StringRef implVendor, URL& sealBase);
+    ANDROID_EXPORT virtual std::passed_ptr<Package> definePackage(StringRef name, StringRef specTitle, StringRef specVersion, StringRef specVendor, StringRef implTitle, StringRef implVersion, StringRef implVendor, const URL& sealBase);
     // Returns a Package that has been defined by this class loader or any of its ancestors. 
     ANDROID_EXPORT virtual std::passed_ptr<Package> getPackage(StringRef name);
     // Finds the class with the specified binary name.
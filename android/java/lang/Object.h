@@ -25,6 +25,9 @@
 
 #pragma once
 
+#include <android++/ExportMacros.h>
+
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -35,7 +38,9 @@ class Lockable {
 public:
     void acquireLock()
     {
-        m_threadMutex.lock();
+        // Only a contended lock takes the out of line path, where StrictMode may time the wait.
+        if (!m_threadMutex.try_lock())
+            acquireContendedLock();
     }
 
     void releaseLock()
@@ -55,6 +60,13 @@ public:
         lock.release();
     }
 
+    template<typename Rep, typename Period> void wait(std::chrono::duration<Rep, Period> timeout)
+    {
+        std::unique_lock<std::mutex> lock(m_threadMutex, std::adopt_lock);
+        m_threadWaiter.wait_for(lock, timeout);
+        lock.release();
+    }
+
     void threadExiting()
     {
         notifyAll();
@@ -64,6 +76,8 @@ public:
     virtual ~Lockable() = default;
 
 private:
+    ANDROID_EXPORT void acquireContendedLock();
+
     std::mutex m_threadMutex;
     std::condition_variable m_threadWaiter;
 };
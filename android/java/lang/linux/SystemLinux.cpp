@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "System.h"
+
+#include <android/os/StrictMode.h>
+#include <android++/StringConversion.h>
+
+#include <dlfcn.h>
+#include <limits.h>
+#include <unistd.h>
+
+namespace java {
+namespace lang {
+
+int64_t System::getProcessId()
+{
+    static const int64_t myPid = ::getpid();
+    return myPid;
+}
+
+static String directoryOf(const std::string& path)
+{
+    size_t separator = path.rfind('/');
+    return std::s2ws(separator == std::string::npos ? std::string(".") : path.substr(0, separator));
+}
+
+String System::getSystemPath()
+{
+    Dl_info info;
+    if (!::dladdr(reinterpret_cast<void*>(&System::getSystemPath), &info) || !info.dli_fname) {
+        assert(false);
+        return L"";
+    }
+
+    return directoryOf(info.dli_fname);
+}
+
+String System::getModulePath(StringRef moduleName)
+{
+    return currentProcessPath() + L"/lib" + moduleName + L".so";
+}
+
+String System::currentProcessPath()
+{
+    char path[PATH_MAX];
+    ssize_t length = ::readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (length < 0) {
+        assert(false);
+        return L"";
+    }
+
+    return directoryOf(std::string(path, length));
+}
+
+void System::loadLibrary(String& libName)
+{
+    StrictMode::BlockingCall blockingCall(StrictMode::DISK_READ, "System::loadLibrary");
+    if (!::dlopen(std::ws2s(libName).c_str(), RTLD_NOW)) {
+        assert(false);
+    }
+}
+
+} // namespace lang
+} // namespace java
@@ -25,6 +25,7 @@
 
 #include "System.h"
 
+#include <android/os/StrictMode.h>
 #include <android++/StringConversion.h>
 
 #include <shlwapi.h>
@@ -84,6 +85,7 @@ String System::currentProcessPath()
 
 void System::loadLibrary(String& libName)
 {
+    StrictMode::BlockingCall blockingCall(StrictMode::DISK_READ, "System::loadLibrary");
     HMODULE libraryModule = ::LoadLibraryW(libName.c_str());
     if (!libraryModule) {
         DWORD error = ::GetLastError();
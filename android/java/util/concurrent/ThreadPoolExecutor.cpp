@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ThreadPoolExecutor.h"
+
+#include <android/os/Handler.h>
+#include <android++/NeverDestroyed.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace java {
+namespace util {
+namespace concurrent {
+
+struct ThreadPoolExecutor::Task {
+    runnable_t command;
+};
+
+// A Chase-Lev work stealing deque of fixed capacity. Only the worker owning it pushes and pops, at the bottom, while
+// other workers steal from the top.
+class ThreadPoolExecutor::TaskDeque {
+    NONCOPYABLE(TaskDeque);
+public:
+    TaskDeque(size_t capacity)
+        : m_capacity(roundUpToPowerOfTwo(capacity))
+        , m_tasks(new std::atomic<Task*>[m_capacity])
+    {
+    }
+    ~TaskDeque()
+    {
+        assert(m_top.load() == m_bottom.load());
+    }
+
+    // Returns false if the deque is full.
+    bool push(Task* task)
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<int64_t>(m_capacity))
+            return false;
+
+        m_tasks[bottom & (m_capacity - 1)].store(task, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    Task* pop()
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Task* task = m_tasks[bottom & (m_capacity - 1)].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // The last task may be stolen at the same time.
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                task = nullptr;
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    // May fail spuriously when racing with another thief or with the owner.
+    Task* steal()
+    {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = m_bottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+            return nullptr;
+
+        Task* task = m_tasks[top & (m_capacity - 1)].load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return task;
+    }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    size_t m_capacity;
+    std::unique_ptr<std::atomic<Task*>[]> m_tasks;
+    std::atomic<int64_t> m_top { 0 };
+    std::atomic<int64_t> m_bottom { 0 };
+};
+
+class ThreadPoolExecutor::Worker {
+    NONCOPYABLE(Worker);
+public:
+    Worker(size_t index, size_t capacity)
+        : index(index)
+    {
+        for (auto& deque : deques)
+            deque = std::make_unique<TaskDeque>(capacity);
+    }
+
+    size_t index;
+    std::unique_ptr<TaskDeque> deques[PRIORITY_COUNT];
+    std::thread thread;
+};
+
+// Lets tasks running on a worker submit to the deques of that worker.
+static thread_local ThreadPoolExecutor* currentExecutor;
+static thread_local size_t currentWorkerIndex;
+
+ThreadPoolExecutor::ThreadPoolExecutor(int32_t workerCount, int32_t queueCapacity)
+{
+    assert(queueCapacity > 0);
+    if (workerCount <= 0)
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_submittedCapacity = static_cast<size_t>(queueCapacity) * workerCount;
+    for (int32_t i = 0; i < workerCount; ++i)
+        m_workers.push_back(std::make_unique<Worker>(i, queueCapacity));
+
+    // Workers steal from each other, so none of them starts before all of them exist.
+    for (auto& worker : m_workers) {
+        Worker* runningWorker = worker.get();
+        worker->thread = std::thread([this, runningWorker] { workerLoop(*runningWorker); });
+    }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+    shutdown();
+    awaitTermination();
+}
+
+ThreadPoolExecutor& ThreadPoolExecutor::getDefault()
+{
+    static NeverDestroyed<ThreadPoolExecutor> defaultExecutor;
+    return defaultExecutor;
+}
+
+void ThreadPoolExecutor::execute(runnable_t&& command)
+{
+    if (!enqueue(std::move(command), PRIORITY_NORMAL))
+        command();
+}
+
+bool ThreadPoolExecutor::execute(runnable_t&& command, Priority priority)
+{
+    return enqueue(std::move(command), priority);
+}
+
+bool ThreadPoolExecutor::execute(runnable_t&& task, Priority priority, android::os::Handler& handler, runnable_t&& completion)
+{
+    android::os::Handler* completionHandler = &handler;
+    return enqueue([task = std::move(task), completionHandler, completion = std::move(completion)] () mutable {
+        task();
+        completionHandler->post(std::move(completion));
+    }, priority);
+}
+
+void ThreadPoolExecutor::shutdown()
+{
+    synchronized (this) {
+        m_shutdown = true;
+        notifyAll();
+    }
+}
+
+bool ThreadPoolExecutor::isShutdown()
+{
+    return m_shutdown;
+}
+
+void ThreadPoolExecutor::awaitTermination()
+{
+    assert(m_shutdown && currentExecutor != this);
+    for (auto& worker : m_workers) {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+}
+
+int32_t ThreadPoolExecutor::getPoolSize() const
+{
+    return static_cast<int32_t>(m_workers.size());
+}
+
+bool ThreadPoolExecutor::enqueue(runnable_t&& command, Priority priority)
+{
+    assert(priority >= PRIORITY_HIGH && priority < PRIORITY_COUNT);
+    if (m_shutdown)
+        return false;
+
+    // Counted before the task becomes visible, so that no worker can decide there is nothing left while it is queued.
+    m_pendingCount.fetch_add(1);
+
+    Task* task = new Task { std::move(command) };
+    bool queued = (currentExecutor == this) && m_workers[currentWorkerIndex]->deques[priority]->push(task);
+    if (!queued) {
+        synchronized (this) {
+            if (!m_shutdown && m_submittedTasks[priority].size() < m_submittedCapacity) {
+                m_submittedTasks[priority].push_back(task);
+                m_submittedCount.fetch_add(1);
+                queued = true;
+            }
+        }
+    }
+
+    if (!queued) {
+        m_pendingCount.fetch_sub(1);
+        command = std::move(task->command);
+        delete task;
+        return false;
+    }
+
+    if (m_idleCount.load() > 0) {
+        synchronized (this) {
+            notifyAll();
+        }
+    }
+    return true;
+}
+
+ThreadPoolExecutor::Task* ThreadPoolExecutor::takeTask(Worker& worker)
+{
+    for (int32_t priority = PRIORITY_HIGH; priority < PRIORITY_COUNT; ++priority) {
+        if (Task* task = worker.deques[priority]->pop())
+            return task;
+
+        if (m_submittedCount.load(std::memory_order_relaxed) > 0) {
+            synchronized (this) {
+                auto& submittedTasks = m_submittedTasks[priority];
+                if (!submittedTasks.empty()) {
+                    Task* task = submittedTasks.front();
+                    submittedTasks.pop_front();
+                    m_submittedCount.fetch_sub(1);
+                    return task;
+                }
+            }
+        }
+
+        if (Task* task = stealTask(worker, static_cast<Priority>(priority)))
+            return task;
+    }
+
+    return nullptr;
+}
+
+ThreadPoolExecutor::Task* ThreadPoolExecutor::stealTask(Worker& thief, Priority priority)
+{
+    size_t workerCount = m_workers.size();
+    for (size_t i = 1; i < workerCount; ++i) {
+        Worker& victim = *m_workers[(thief.index + i) % workerCount];
+        if (Task* task = victim.deques[priority]->steal())
+            return task;
+    }
+
+    return nullptr;
+}
+
+void ThreadPoolExecutor::workerLoop(Worker& worker)
+{
+    currentExecutor = this;
+    currentWorkerIndex = worker.index;
+
+    while (true) {
+        if (Task* task = takeTask(worker)) {
+            m_pendingCount.fetch_sub(1);
+            task->command();
+            delete task;
+            continue;
+        }
+
+        bool terminating = false;
+        synchronized (this) {
+            m_idleCount.fetch_add(1);
+            while (!m_shutdown && m_pendingCount.load() <= 0)
+                wait();
+            m_idleCount.fetch_sub(1);
+
+            // Tasks submitted before the shutdown, including those they submit in turn, all run first.
+            terminating = m_shutdown && m_pendingCount.load() <= 0;
+        }
+
+        if (terminating)
+            break;
+    }
+
+    currentExecutor = nullptr;
+}
+
+} // namespace concurrent
+} // namespace util
+} // namespace java
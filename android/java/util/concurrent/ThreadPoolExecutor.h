@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <java/util/concurrent/Executor.h>
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+namespace android {
+namespace os {
+class Handler;
+}
+}
+
+namespace java {
+namespace util {
+namespace concurrent {
+
+// An Executor which runs tasks on a pool of worker threads. Tasks submitted from a worker go to deques of that worker,
+// which the other workers steal from when they run out of work; tasks submitted from other threads are shared by all
+// workers. Within each of these queues, higher priority tasks are taken first.
+class ThreadPoolExecutor final : public Executor, public Object {
+    NONCOPYABLE(ThreadPoolExecutor);
+public:
+    enum Priority {
+        PRIORITY_HIGH,
+        PRIORITY_NORMAL,
+        PRIORITY_LOW,
+        PRIORITY_COUNT
+    };
+
+    // Creates a pool of workerCount threads, or of one thread per core if workerCount is 0. Each worker holds up to
+    // queueCapacity tasks of each priority, and as many may be waiting per worker for any worker to take them.
+    ANDROID_EXPORT ThreadPoolExecutor(int32_t workerCount = 0, int32_t queueCapacity = 1024);
+    // Shuts the pool down, and waits for the tasks which were already submitted to complete.
+    ANDROID_EXPORT ~ThreadPoolExecutor();
+
+    // Returns a pool shared by the whole process, with one thread per core.
+    ANDROID_EXPORT static ThreadPoolExecutor& getDefault();
+
+    // Executes command with normal priority. If the pool can't take it, command runs on the calling thread.
+    ANDROID_EXPORT void execute(runnable_t&& command) override;
+    // Executes command with the given priority. Returns false, leaving command untouched, if the pool has been shut
+    // down or its queues are full.
+    ANDROID_EXPORT bool execute(runnable_t&& command, Priority priority);
+    // Executes task with the given priority, then posts completion to handler, which must outlive the task.
+    ANDROID_EXPORT bool execute(runnable_t&& task, Priority priority, android::os::Handler& handler, runnable_t&& completion);
+
+    // Stops accepting new tasks. Tasks which were already submitted still run.
+    ANDROID_EXPORT void shutdown();
+    // Returns true if this executor has been shut down.
+    ANDROID_EXPORT bool isShutdown();
+    // Waits until all tasks have completed after a shutdown request.
+    ANDROID_EXPORT void awaitTermination();
+
+    // Returns the number of threads in the pool.
+    ANDROID_EXPORT int32_t getPoolSize() const;
+
+private:
+    struct Task;
+    class TaskDeque;
+    class Worker;
+
+    bool enqueue(runnable_t&&, Priority);
+    Task* takeTask(Worker&);
+    Task* stealTask(Worker&, Priority);
+    void workerLoop(Worker&);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    // Tasks submitted from threads which aren't workers of this pool.
+    std::deque<Task*> m_submittedTasks[PRIORITY_COUNT];
+    size_t m_submittedCapacity;
+    std::atomic<int32_t> m_submittedCount { 0 };
+    // Tasks which have been queued and not taken yet, and workers waiting for one.
+    std::atomic<int32_t> m_pendingCount { 0 };
+    std::atomic<int32_t> m_idleCount { 0 };
+    std::atomic<bool> m_shutdown { false };
+};
+
+} // namespace concurrent
+} // namespace util
+} // namespace java
+
+using ThreadPoolExecutor = java::util::concurrent::ThreadPoolExecutor;
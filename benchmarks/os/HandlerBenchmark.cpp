@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/os/Handler.h>
+#include <android/os/Looper.h>
+
+#include <random>
+#include <stdio.h>
+#include <thread>
+
+// Measures Handler enqueue and dispatch cost while a given number of delayed items are already pending.
+
+static const int32_t pendingCounts[] = { 10, 1000, 100000 };
+static const int32_t dispatchCount = 10000;
+
+struct Result {
+    double enqueueNanosPerItem;
+    double dispatchNanosPerItem;
+};
+
+static double nanosPerItem(std::chrono::steady_clock::time_point start, int32_t count)
+{
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / count;
+}
+
+static Result measure(int32_t pendingCount)
+{
+    Result result;
+
+    Looper::prepare();
+    Handler handler;
+
+    // Pending items are spread over an hour in the future, so they are never dispatched during the run.
+    std::mt19937 random(pendingCount);
+    std::uniform_int_distribution<int32_t> delays(0, 60 * 60 * 1000);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < pendingCount; ++i)
+        handler.postDelayed([] { }, 1h + std::chrono::milliseconds(delays(random)));
+    result.enqueueNanosPerItem = nanosPerItem(start, pendingCount);
+
+    int32_t remaining = dispatchCount;
+    for (int32_t i = 0; i < dispatchCount; ++i) {
+        handler.post([&remaining] {
+            if (--remaining == 0)
+                Looper::myLooper()->quit();
+        });
+    }
+
+    start = std::chrono::steady_clock::now();
+    Looper::loop();
+    result.dispatchNanosPerItem = nanosPerItem(start, dispatchCount);
+
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    printf("%-10s %18s %18s\n", "pending", "enqueue (ns/item)", "dispatch (ns/item)");
+
+    for (int32_t pendingCount : pendingCounts) {
+        Result result;
+        // Every run gets a thread of its own, so it starts from a fresh Looper.
+        std::thread([&] { result = measure(pendingCount); }).join();
+        printf("%-10d %18.1f %18.1f\n", pendingCount, result.enqueueNanosPerItem, result.dispatchNanosPerItem);
+    }
+
+    return 0;
+}
@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/os/Handler.h>
+#include <android/os/Looper.h>
+#include <android/os/Message.h>
+#include <android/os/SystemClock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// Measures the core Handler and Looper paths. Every result is printed as one JSON object per line, so runs can be
+// collected and compared by scripts. An optional argument runs only the benchmarks whose name contains it.
+
+static void report(const char* benchmark, const char* metric, double value, const char* unit)
+{
+    printf("{\"benchmark\": \"%s\", \"metric\": \"%s\", \"value\": %.3f, \"unit\": \"%s\"}\n", benchmark, metric, value, unit);
+    fflush(stdout);
+}
+
+static double nanosPerItem(std::chrono::steady_clock::time_point start, int32_t count)
+{
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / count;
+}
+
+static double percentile(std::vector<double>& samples, int32_t percent)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, samples.size() * percent / 100)];
+}
+
+static double toMicros(std::chrono::nanoseconds nanos)
+{
+    return std::chrono::duration<double, std::micro>(nanos).count();
+}
+
+static void postSameThread()
+{
+    static const int32_t postCount = 200000;
+
+    Looper::prepare();
+    Handler handler;
+
+    int32_t remaining = postCount;
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < postCount; ++i) {
+        handler.post([&remaining] {
+            if (--remaining == 0)
+                Looper::myLooper()->quit();
+        });
+    }
+    double enqueueNanos = nanosPerItem(start, postCount);
+
+    start = std::chrono::steady_clock::now();
+    Looper::loop();
+    double dispatchNanos = nanosPerItem(start, postCount);
+
+    report("post_same_thread", "enqueue", enqueueNanos, "ns/op");
+    report("post_same_thread", "dispatch", dispatchNanos, "ns/op");
+}
+
+static void postCrossThread()
+{
+    static const int32_t producerCount = 4;
+    static const int32_t postsPerProducer = 50000;
+
+    Looper::prepare();
+    Handler handler;
+
+    int32_t remaining = producerCount * postsPerProducer;
+    std::atomic<bool> go { false };
+    std::vector<std::thread> producers;
+    for (int32_t i = 0; i < producerCount; ++i) {
+        producers.emplace_back([&] {
+            while (!go)
+                std::this_thread::yield();
+            for (int32_t j = 0; j < postsPerProducer; ++j) {
+                handler.post([&remaining] {
+                    if (--remaining == 0)
+                        Looper::myLooper()->quit();
+                });
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go = true;
+    Looper::loop();
+    double nanos = nanosPerItem(start, producerCount * postsPerProducer);
+
+    for (auto& producer : producers)
+        producer.join();
+
+    report("post_cross_thread", "throughput", 1e9 / nanos, "items/s");
+}
+
+class LatenessHandler : public Handler {
+public:
+    LatenessHandler(int32_t sampleCount, std::chrono::milliseconds delay)
+        : m_remaining(sampleCount)
+        , m_delay(delay)
+    {
+    }
+
+    void start()
+    {
+        m_expectedTime = SystemClock::uptimeNanos() + m_delay;
+        sendEmptyMessageDelayed(0, m_delay);
+    }
+
+    void handleMessage(Message&) override
+    {
+        m_latenessMicros.push_back(toMicros(SystemClock::uptimeNanos() - m_expectedTime));
+        if (--m_remaining == 0) {
+            Looper::myLooper()->quit();
+            return;
+        }
+        start();
+    }
+
+    std::vector<double>& latenessMicros() { return m_latenessMicros; }
+
+private:
+    int32_t m_remaining;
+    std::chrono::milliseconds m_delay;
+    std::chrono::nanoseconds m_expectedTime;
+    std::vector<double> m_latenessMicros;
+};
+
+static void sendMessageDelayedAccuracy()
+{
+    Looper::prepare();
+    LatenessHandler handler(250, std::chrono::milliseconds(2));
+    handler.start();
+    Looper::loop();
+
+    report("send_message_delayed", "lateness_p50", percentile(handler.latenessMicros(), 50), "us");
+    report("send_message_delayed", "lateness_p99", percentile(handler.latenessMicros(), 99), "us");
+}
+
+static void crossThreadPingPong()
+{
+    static const int32_t roundTripCount = 10000;
+
+    std::promise<Handler*> echoReady;
+    std::thread echoThread([&] {
+        Looper::prepare();
+        Handler echo;
+        echoReady.set_value(&echo);
+        Looper::loop();
+    });
+    Handler* echo = echoReady.get_future().get();
+
+    Looper::prepare();
+    Handler home;
+
+    std::vector<double> roundTripMicros;
+    roundTripMicros.reserve(roundTripCount);
+    std::function<void ()> ping = [&] {
+        std::chrono::nanoseconds sentTime = SystemClock::uptimeNanos();
+        echo->post([&, sentTime] {
+            home.post([&, sentTime] {
+                roundTripMicros.push_back(toMicros(SystemClock::uptimeNanos() - sentTime));
+                if (roundTripMicros.size() == roundTripCount)
+                    Looper::myLooper()->quit();
+                else
+                    ping();
+            });
+        });
+    };
+
+    ping();
+    Looper::loop();
+
+    echo->post([] { Looper::myLooper()->quit(); });
+    echoThread.join();
+
+    report("ping_pong", "round_trip_p50", percentile(roundTripMicros, 50), "us");
+    report("ping_pong", "round_trip_p99", percentile(roundTripMicros, 99), "us");
+}
+
+static void removeMessagesFromLargeQueue()
+{
+    static const int32_t pendingCount = 100000;
+    static const int32_t whatCount = 1000;
+    static const int32_t removeCount = 100;
+
+    Looper::prepare();
+    Handler handler;
+
+    for (int32_t i = 0; i < pendingCount; ++i)
+        handler.sendEmptyMessageDelayed(i % whatCount, std::chrono::hours(1));
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t what = 0; what < removeCount; ++what)
+        handler.removeMessages(what);
+    double removeMessagesNanos = nanosPerItem(start, removeCount);
+
+    start = std::chrono::steady_clock::now();
+    handler.removeCallbacksAndMessages(nullptr);
+    double removeAllNanos = nanosPerItem(start, 1);
+
+    handler.post([] { Looper::myLooper()->quit(); });
+    Looper::loop();
+
+    report("remove_messages", "remove_what", removeMessagesNanos / 1000, "us/op");
+    report("remove_messages", "remove_all", removeAllNanos / 1000, "us/op");
+}
+
+static double copyMessage(const Message& message, int32_t copyCount)
+{
+    volatile int32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < copyCount; ++i) {
+        Message copy(message);
+        sink = sink + copy.what;
+    }
+    return nanosPerItem(start, copyCount);
+}
+
+static void messageCopy()
+{
+    static const int32_t copyCount = 1000000;
+
+    Message message = Message::obtain(nullptr, 1, 2, 3);
+    report("message_copy", "without_bundle", copyMessage(message, copyCount), "ns/op");
+
+    message.getData().putInt(L"key", 1);
+    report("message_copy", "with_bundle", copyMessage(message, copyCount), "ns/op");
+}
+
+static void spinFor(std::chrono::nanoseconds duration)
+{
+    std::chrono::nanoseconds endTime = SystemClock::uptimeNanos() + duration;
+    while (SystemClock::uptimeNanos() < endTime) { }
+}
+
+static void inputUnderBackgroundWork()
+{
+    static const int32_t backgroundCount = 20000;
+    static const int32_t inputCount = 500;
+
+    Looper::prepare();
+    Handler background(Looper::myLooper(), false, Handler::PRIORITY_BACKGROUND);
+    Handler input(Looper::myLooper(), false, Handler::PRIORITY_INPUT);
+
+    for (int32_t i = 0; i < backgroundCount; ++i)
+        background.post([] { spinFor(std::chrono::microseconds(50)); });
+
+    // Input arrives from another thread while the bulk work runs, as it would from the window system.
+    std::vector<double> latencyMicros;
+    latencyMicros.reserve(inputCount);
+    std::thread inputThread([&] {
+        for (int32_t i = 0; i < inputCount; ++i) {
+            std::chrono::nanoseconds postTime = SystemClock::uptimeNanos();
+            input.post([&, postTime] {
+                latencyMicros.push_back(toMicros(SystemClock::uptimeNanos() - postTime));
+                if (latencyMicros.size() == inputCount)
+                    Looper::myLooper()->quit();
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    Looper::loop();
+    inputThread.join();
+
+    report("input_under_background", "latency_p50", percentile(latencyMicros, 50), "us");
+    report("input_under_background", "latency_p99", percentile(latencyMicros, 99), "us");
+}
+
+struct Benchmark {
+    const char* name;
+    void (*run)();
+};
+
+static const Benchmark benchmarks[] = {
+    { "post_same_thread", postSameThread },
+    { "post_cross_thread", postCrossThread },
+    { "send_message_delayed", sendMessageDelayedAccuracy },
+    { "ping_pong", crossThreadPingPong },
+    { "remove_messages", removeMessagesFromLargeQueue },
+    { "message_copy", messageCopy },
+    { "input_under_background", inputUnderBackgroundWork },
+};
+
+int main(int argc, char* argv[])
+{
+    const char* filter = (argc > 1) ? argv[1] : nullptr;
+
+    for (const Benchmark& benchmark : benchmarks) {
+        if (filter && !strstr(benchmark.name, filter))
+            continue;
+
+        // Every benchmark gets a thread of its own, so it starts from a fresh Looper.
+        std::thread(benchmark.run).join();
+    }
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2017 Daewoong Jang.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/os/Handler.h>
+#include <android/os/Looper.h>
+#include <android/os/Message.h>
+#include <android/os/SystemClock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// Checks timing guarantees of Handler and Looper which the benchmarks only measure. Every check prints PASS or FAIL
+// with what it observed, and the exit code is non-zero if any failed. An optional argument runs only the checks
+// whose name contains it.
+
+static double toMicros(std::chrono::nanoseconds nanos)
+{
+    return std::chrono::duration<double, std::micro>(nanos).count();
+}
+
+static void spinFor(std::chrono::nanoseconds duration)
+{
+    std::chrono::nanoseconds endTime = SystemClock::uptimeNanos() + duration;
+    while (SystemClock::uptimeNanos() < endTime) { }
+}
+
+// Input posted from another thread while a long run of background work is dispatched is performed within one
+// dispatch time slice, right after the item which is running, instead of waiting for the run to yield.
+static bool inputDuringBackgroundWork()
+{
+    static const int32_t backgroundCount = 4000;
+    static const int32_t inputCount = 20;
+    static const std::chrono::nanoseconds dispatchTimeSlice = std::chrono::milliseconds(4);
+
+    Looper::prepare();
+    Handler background(Looper::myLooper(), false, Handler::PRIORITY_BACKGROUND);
+    Handler input(Looper::myLooper(), false, Handler::PRIORITY_INPUT);
+
+    std::atomic<bool> backgroundStarted { false };
+    for (int32_t i = 0; i < backgroundCount; ++i) {
+        background.post([&] {
+            backgroundStarted = true;
+            spinFor(std::chrono::microseconds(50));
+        });
+    }
+
+    std::vector<std::chrono::nanoseconds> latencies;
+    std::thread inputThread([&] {
+        while (!backgroundStarted)
+            std::this_thread::yield();
+        for (int32_t i = 0; i < inputCount; ++i) {
+            std::chrono::nanoseconds postTime = SystemClock::uptimeNanos();
+            input.post([&, postTime] {
+                latencies.push_back(SystemClock::uptimeNanos() - postTime);
+                if (latencies.size() == inputCount)
+                    Looper::myLooper()->quit();
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    });
+
+    Looper::loop();
+    inputThread.join();
+
+    // Waiting for the background run to yield would make the typical input wait about half a slice.
+    std::sort(latencies.begin(), latencies.end());
+    std::chrono::nanoseconds medianLatency = latencies[latencies.size() / 2];
+    std::chrono::nanoseconds maxLatency = latencies.back();
+    printf("  input latency median %.1f us, longest %.1f us, slice %.1f us\n", toMicros(medianLatency), toMicros(maxLatency), toMicros(dispatchTimeSlice));
+    return medianLatency < dispatchTimeSlice / 4 && maxLatency < dispatchTimeSlice;
+}
+
+class EarlinessHandler : public Handler {
+public:
+    EarlinessHandler(int32_t sampleCount, std::chrono::milliseconds delay)
+        : m_remaining(sampleCount)
+        , m_delay(delay)
+    {
+    }
+
+    void start()
+    {
+        m_earliestTime = SystemClock::uptimeNanos() + m_delay;
+        sendEmptyMessageDelayed(0, m_delay);
+    }
+
+    void handleMessage(Message&) override
+    {
+        m_minLateness = std::min(m_minLateness, SystemClock::uptimeNanos() - m_earliestTime);
+        if (--m_remaining == 0) {
+            Looper::myLooper()->quit();
+            return;
+        }
+        start();
+    }
+
+    std::chrono::nanoseconds minLateness() const { return m_minLateness; }
+
+private:
+    int32_t m_remaining;
+    std::chrono::milliseconds m_delay;
+    std::chrono::nanoseconds m_earliestTime;
+    std::chrono::nanoseconds m_minLateness { std::chrono::nanoseconds::max() };
+};
+
+// A delayed message never runs before the time it was sent plus its delay, to the nanosecond.
+static bool delayedMessageNeverEarly()
+{
+    Looper::prepare();
+    EarlinessHandler handler(200, std::chrono::milliseconds(1));
+    handler.start();
+    Looper::loop();
+
+    printf("  smallest lateness %.3f us\n", toMicros(handler.minLateness()));
+    return handler.minLateness() >= std::chrono::nanoseconds::zero();
+}
+
+// A thread on virtual time which posts to a looper on real time schedules the work on the real clock, whatever
+// its own clock reads.
+static bool virtualThreadPostsToRealLooper()
+{
+    static const std::chrono::milliseconds delay(10);
+    static const std::chrono::seconds timeout(2);
+
+    std::promise<Handler*> realReady;
+    std::thread realThread([&] {
+        Looper::prepare();
+        Handler real;
+        realReady.set_value(&real);
+        Looper::loop();
+    });
+    Handler* real = realReady.get_future().get();
+
+    Looper::prepareVirtualTime();
+    Looper::myLooper()->advanceBy(std::chrono::hours(1));
+
+    std::promise<std::chrono::nanoseconds> ran;
+    std::chrono::nanoseconds postTime = SystemClock::steadyUptimeNanos();
+    real->postDelayed([&] { ran.set_value(SystemClock::steadyUptimeNanos()); }, delay);
+
+    std::future<std::chrono::nanoseconds> runTime = ran.get_future();
+    bool passed = runTime.wait_for(timeout) == std::future_status::ready;
+    if (passed) {
+        std::chrono::nanoseconds elapsed = runTime.get() - postTime;
+        printf("  ran after %.1f us, delay %.1f us\n", toMicros(elapsed), toMicros(delay));
+        passed = elapsed >= delay;
+    } else {
+        printf("  didn't run within %lld s\n", static_cast<long long>(timeout.count()));
+    }
+
+    // Quitting through a post would be scheduled on the virtual clock as well, if the check fails.
+    real->getLooper()->quit();
+    realThread.join();
+    return passed;
+}
+
+// Keeps its callback in a member, the way a Runnable field is posted and removed again.
+class Ticker {
+public:
+    explicit Ticker(Handler& handler)
+        : m_handler(handler)
+        , m_tick([this] { ++m_ticks; })
+    {
+    }
+
+    void schedule() { m_handler.postDelayed(m_tick, std::chrono::milliseconds(1)); }
+    void cancel() { m_handler.removeCallbacks(m_tick); }
+    int32_t ticks() const { return m_ticks; }
+
+private:
+    Handler& m_handler;
+    std::function<void ()> m_tick;
+    int32_t m_ticks { 0 };
+};
+
+// removeCallbacks() removes the posts of the callable it is given, not those of other objects which post a lambda
+// of the same type through the same handler.
+static bool removeCallbacksByIdentity()
+{
+    Looper::prepare();
+    Handler handler;
+
+    Ticker removed(handler);
+    Ticker kept(handler);
+    removed.schedule();
+    kept.schedule();
+    kept.schedule();
+    removed.cancel();
+    handler.postDelayed([] { Looper::myLooper()->quit(); }, std::chrono::milliseconds(5));
+    Looper::loop();
+
+    printf("  removed ticker ran %d times, kept ticker ran %d times\n", removed.ticks(), kept.ticks());
+    return removed.ticks() == 0 && kept.ticks() == 2;
+}
+
+struct Check {
+    const char* name;
+    bool (*run)();
+};
+
+static const Check checks[] = {
+    { "input_during_background", inputDuringBackgroundWork },
+    { "delayed_message_never_early", delayedMessageNeverEarly },
+    { "virtual_thread_posts_to_real_looper", virtualThreadPostsToRealLooper },
+    { "remove_callbacks_by_identity", removeCallbacksByIdentity },
+};
+
+int main(int argc, char* argv[])
+{
+    const char* filter = (argc > 1) ? argv[1] : nullptr;
+
+    int32_t failures = 0;
+    for (const Check& check : checks) {
+        if (filter && !strstr(check.name, filter))
+            continue;
+
+        // Every check gets a thread of its own, so it starts from a fresh Looper.
+        bool passed = false;
+        std::thread([&] { passed = check.run(); }).join();
+        printf("%s %s\n", passed ? "PASS" : "FAIL", check.name);
+        if (!passed)
+            ++failures;
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/os/Handler.h>
+#include <android/os/Looper.h>
+
+#include <atomic>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+// Measures how posting from other threads scales as the number of producers grows, with the Looper thread
+// draining everything they post.
+
+static const int32_t producerCounts[] = { 1, 2, 4, 8, 16, 32 };
+static const int32_t postCount = 1 << 20;
+
+struct Result {
+    double postNanosPerItem;
+    double itemsPerSecond;
+};
+
+static Result measure(int32_t producerCount)
+{
+    Result result;
+
+    Looper::prepare();
+    Handler handler;
+
+    const int32_t postsPerProducer = postCount / producerCount;
+    const int32_t totalCount = postsPerProducer * producerCount;
+    int32_t remaining = totalCount;
+
+    std::atomic<int32_t> readyCount { 0 };
+    std::atomic<bool> go { false };
+    std::atomic<int64_t> postNanos { 0 };
+
+    std::vector<std::thread> producers;
+    for (int32_t i = 0; i < producerCount; ++i) {
+        producers.emplace_back([&] {
+            ++readyCount;
+            while (!go)
+                std::this_thread::yield();
+
+            auto start = std::chrono::steady_clock::now();
+            for (int32_t j = 0; j < postsPerProducer; ++j) {
+                handler.post([&remaining] {
+                    if (--remaining == 0)
+                        Looper::myLooper()->quit();
+                });
+            }
+            postNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        });
+    }
+
+    while (readyCount < producerCount)
+        std::this_thread::yield();
+
+    auto start = std::chrono::steady_clock::now();
+    go = true;
+    Looper::loop();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    for (auto& producer : producers)
+        producer.join();
+
+    result.postNanosPerItem = static_cast<double>(postNanos) / totalCount;
+    result.itemsPerSecond = totalCount / elapsed.count();
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    printf("%-10s %18s %18s\n", "producers", "post (ns/item)", "drained (items/s)");
+
+    for (int32_t producerCount : producerCounts) {
+        Result result;
+        // Every run gets a thread of its own, so it starts from a fresh Looper.
+        std::thread([&] { result = measure(producerCount); }).join();
+        printf("%-10d %18.1f %18.0f\n", producerCount, result.postNanosPerItem, result.itemsPerSecond);
+    }
+
+    return 0;
+}
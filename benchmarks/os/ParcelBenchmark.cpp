@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/os/Bundle.h>
+#include <android/os/Message.h>
+#include <android/os/Parcel.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Measures Message::writeToParcel() for messages carrying Bundles of various sizes, into a fresh Parcel and into
+// one whose capacity was set up front. The fields of those Bundles are then written into replicas of the Parcel
+// buffer before and after it grew geometrically, as a baseline, and into a Parcel. Last, a float array is written
+// and read element by element and in bulk.
+
+static const int32_t bundleSizes[] = { 1024, 64 * 1024, 1024 * 1024 };
+
+// Each key holds an int, and the key with ".text" appended a CharSequence of 64 characters.
+static std::vector<String> makeKeys(int32_t bundleSize)
+{
+    std::vector<String> keys;
+    int32_t size = 0;
+    for (int32_t i = 0; size < bundleSize; ++i) {
+        keys.push_back(L"key." + std::to_wstring(i));
+        size += static_cast<int32_t>((keys.back().length() * 2 + 5 + 64) * sizeof(wchar_t) + 40);
+    }
+    return keys;
+}
+
+static Message makeMessage(int32_t bundleSize)
+{
+    Bundle bundle;
+    std::vector<String> keys = makeKeys(bundleSize);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        bundle.putInt(keys[i], static_cast<int32_t>(i));
+        bundle.putCharSequence(keys[i] + L".text", CharSequence(64, L'x'));
+    }
+
+    Message message = Message::obtain();
+    message.what = 1;
+    message.setData(std::move(bundle));
+    return message;
+}
+
+static double microsPerMessage(const Message& message, int32_t iterations, int32_t capacity)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < iterations; ++i) {
+        Parcel parcel;
+        if (capacity)
+            parcel.setDataCapacity(capacity);
+        message.writeToParcel(parcel, 0);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+static const int32_t arrayLength = 100 * 1000;
+
+template<typename F> static double microsPerIteration(int32_t iterations, F function)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < iterations; ++i)
+        function();
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+// Replicas of the Parcel buffer before and after it grew geometrically, written to the way ByteWriter writes. They
+// leave out everything else a Parcel does per write, so they compare the growth alone.
+class ReplicaBuffer {
+public:
+    virtual ~ReplicaBuffer() = default;
+
+    ReplicaBuffer& operator<<(int64_t value)
+    {
+        write(&value, sizeof(value), sizeof(value));
+        return *this;
+    }
+    ReplicaBuffer& operator<<(size_t value)
+    {
+        write(&value, sizeof(value), sizeof(value));
+        return *this;
+    }
+    ReplicaBuffer& operator<<(const CharSequence& value)
+    {
+        size_t length = value.length();
+        write(&length, sizeof(length), sizeof(length));
+        write(value.data(), length * sizeof(CharSequence::value_type), sizeof(CharSequence::value_type));
+        return *this;
+    }
+
+protected:
+    virtual int8_t* grow(size_t length, size_t alignment) = 0;
+
+    static size_t alignLength(size_t length, size_t alignment)
+    {
+        return ((length + alignment - 1) / alignment) * alignment;
+    }
+
+private:
+    void write(const void* in, size_t length, size_t alignment)
+    {
+        memcpy(grow(length, alignment), in, length);
+    }
+};
+
+// Every write resized a std::vector, which cleared the bytes about to be written and reallocated as it saw fit.
+class ClearingBuffer final : public ReplicaBuffer {
+protected:
+    int8_t* grow(size_t length, size_t alignment) override
+    {
+        size_t alignedSize = alignLength(m_buffer.size(), alignment);
+        m_buffer.resize(alignedSize + length);
+        return m_buffer.data() + alignedSize;
+    }
+
+private:
+    std::vector<int8_t> m_buffer;
+};
+
+// The capacity doubles, starting at 256 bytes, and only the alignment padding is cleared.
+class GeometricBuffer final : public ReplicaBuffer {
+protected:
+    int8_t* grow(size_t length, size_t alignment) override
+    {
+        size_t alignedSize = alignLength(m_size, alignment);
+        size_t newSize = alignedSize + length;
+        if (newSize > m_capacity) {
+            size_t capacity = std::max(newSize, std::max(m_capacity * 2, static_cast<size_t>(256)));
+            std::unique_ptr<int8_t[]> buffer(new int8_t[capacity]);
+            if (m_size)
+                memcpy(buffer.get(), m_buffer.get(), m_size);
+            m_buffer = std::move(buffer);
+            m_capacity = capacity;
+        }
+        memset(m_buffer.get() + m_size, 0, alignedSize - m_size);
+        m_size = newSize;
+        return m_buffer.get() + alignedSize;
+    }
+
+private:
+    std::unique_ptr<int8_t[]> m_buffer;
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
+};
+
+// Writes the same fields as Bundle::writeToParcel() does for the Bundles of makeMessage().
+template<typename Writer> static void writeBundleFields(Writer& writer, const std::vector<String>& keys, const std::vector<String>& textKeys, const CharSequence& text)
+{
+    writer << keys.size();
+    for (size_t i = 0; i < keys.size(); ++i)
+        writer << keys[i] << static_cast<int64_t>(i);
+    writer << textKeys.size();
+    for (const String& key : textKeys)
+        writer << key << text;
+    writer << static_cast<size_t>(0);
+}
+
+static void benchmarkBundleFields()
+{
+    printf("\n%-14s %12s %22s %22s %22s %22s\n", "bundle fields", "parcel size", "clear-and-resize (us)", "geometric (us)", "Parcel (us)", "presized (us)");
+
+    const CharSequence text(64, L'x');
+    for (int32_t bundleSize : bundleSizes) {
+        std::vector<String> keys = makeKeys(bundleSize);
+        std::vector<String> textKeys;
+        for (const String& key : keys)
+            textKeys.push_back(key + L".text");
+
+        Parcel parcel;
+        writeBundleFields(parcel, keys, textKeys, text);
+        int32_t parcelSize = parcel.dataSize();
+
+        int32_t iterations = std::max(10, 64 * 1024 * 1024 / parcelSize / 16);
+        double clearing = microsPerIteration(iterations, [&] {
+            ClearingBuffer buffer;
+            writeBundleFields<ReplicaBuffer>(buffer, keys, textKeys, text);
+        });
+        double geometric = microsPerIteration(iterations, [&] {
+            GeometricBuffer buffer;
+            writeBundleFields<ReplicaBuffer>(buffer, keys, textKeys, text);
+        });
+        double fresh = microsPerIteration(iterations, [&] {
+            Parcel parcel;
+            writeBundleFields(parcel, keys, textKeys, text);
+        });
+        double presized = microsPerIteration(iterations, [&] {
+            Parcel parcel;
+            parcel.setDataCapacity(parcelSize);
+            writeBundleFields(parcel, keys, textKeys, text);
+        });
+        printf("%-14d %12d %22.1f %22.1f %22.1f %22.1f\n", bundleSize, parcelSize, clearing, geometric, fresh, presized);
+    }
+}
+
+static void benchmarkFloatArray()
+{
+    std::vector<float> values(arrayLength);
+    for (int32_t i = 0; i < arrayLength; ++i)
+        values[i] = i * 0.5f;
+
+    Parcel written;
+    written.writeFloatArray(values);
+    float sum = 0;
+    const int32_t iterations = 100;
+
+    double writeElements = microsPerIteration(iterations, [&] {
+        Parcel parcel;
+        parcel << values.size();
+        for (float value : values)
+            parcel << value;
+    });
+    double writeArray = microsPerIteration(iterations, [&] {
+        Parcel parcel;
+        parcel.writeFloatArray(values);
+    });
+    double readElements = microsPerIteration(iterations, [&] {
+        Parcel parcel = Parcel::wrap(written.data(), written.dataSize(), nullptr);
+        size_t length = 0;
+        parcel >> length;
+        for (size_t i = 0; i < length; ++i) {
+            float value = 0;
+            parcel >> value;
+            sum += value;
+        }
+    });
+    double createArray = microsPerIteration(iterations, [&] {
+        Parcel parcel = Parcel::wrap(written.data(), written.dataSize(), nullptr);
+        sum += parcel.createFloatArray().back();
+    });
+    double readSpan = microsPerIteration(iterations, [&] {
+        Parcel parcel = Parcel::wrap(written.data(), written.dataSize(), nullptr);
+        sum += parcel.readSpan<float>()[arrayLength - 1];
+    });
+
+    printf("\n%-24s %12s\n", "float[100000]", "time (us)");
+    printf("%-24s %12.1f\n", "operator<< per element", writeElements);
+    printf("%-24s %12.1f\n", "writeFloatArray", writeArray);
+    printf("%-24s %12.1f\n", "operator>> per element", readElements);
+    printf("%-24s %12.1f\n", "createFloatArray", createArray);
+    printf("%-24s %12.1f\n", "readSpan", readSpan);
+    if (sum < 0)
+        printf("%f\n", sum);
+}
+
+int main(int argc, char* argv[])
+{
+    printf("%-12s %12s %22s %22s\n", "bundle", "parcel size", "writeToParcel (us)", "presized (us)");
+
+    for (int32_t bundleSize : bundleSizes) {
+        Message message = makeMessage(bundleSize);
+        Parcel parcel;
+        message.writeToParcel(parcel, 0);
+        int32_t parcelSize = parcel.dataSize();
+
+        int32_t iterations = std::max(10, 64 * 1024 * 1024 / parcelSize / 16);
+        double fresh = microsPerMessage(message, iterations, 0);
+        double presized = microsPerMessage(message, iterations, parcelSize);
+        printf("%-12d %12d %22.1f %22.1f\n", bundleSize, parcelSize, fresh, presized);
+    }
+
+    benchmarkBundleFields();
+    benchmarkFloatArray();
+    return 0;
+}
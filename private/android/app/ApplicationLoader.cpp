@@ -160,7 +160,7 @@ bool ApplicationLoader::onTransaction(int32_t code, Parcel& data, Parcel* reply,
 {
     switch (code) {
     case INITIALIZE_APPLICATION: {
-        auto parcelable = ParcelablePrivate::createFromParcel(data, ParcelableCreator::creator<Intent>().binaryName);
+        auto parcelable = ParcelablePrivate::createFromParcel(data, ParcelableCreator::creator<Intent>().typeId);
         if (!parcelable) {
             LOGA("Received data is not an Intent object");
             break;
@@ -26,6 +26,8 @@
 
 #include "ApplicationProcess.h"
 
+#include <android/os/StrictMode.h>
+
 #include <shlwapi.h>
 
 namespace android {
@@ -149,6 +151,7 @@ bool ApplicationProcess::platformInitialize(std::unordered_map<String, String>&
 
 bool ApplicationProcess::load(StringRef moduleName)
 {
+    StrictMode::BlockingCall blockingCall(StrictMode::DISK_READ, "ApplicationProcess::load");
     HMODULE module = ::LoadLibraryW(moduleName.c_str());
     if (!module) {
         assert(false);
@@ -26,9 +26,9 @@
 #include "MediaPlayerPrivateMock.h"
 
 #include <android/app/ApplicationProcess.h>
+#include <android/os/SystemClock.h>
 
 #include <algorithm>
-#include <unistd.h>
 
 namespace android {
 namespace media {
@@ -99,7 +99,7 @@ void MediaPlayerPrivateMock::stateChanged(State oldState, State newState)
         assert(oldState == Idle);
         break;
     case Prepare:
-        sleep((mediaPrepareLatency + mediaBufferingLatency) / 1000);
+        SystemClock::sleep(std::chrono::milliseconds(mediaPrepareLatency + mediaBufferingLatency));
         onPrepared();
         break;
     case Preparing:
@@ -17,6 +17,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <android/os/StrictMode.h>
+
 ///
 //  Macros
 //
@@ -64,6 +66,7 @@ typedef struct
 //
 int WinTGALoad( const char *fileName, char **buffer, int *width, int *height )
 {
+   StrictMode::BlockingCall blockingCall ( StrictMode::DISK_READ, "esLoadTGA" );
    FILE        *fp;
    TGA_HEADER   Header;
 
@@ -26,8 +26,9 @@
 #include "Binder.h"
 
 #include "BinderProvider.h"
-#include <android/app/ApplicationProcess.h>
 #include <android/os/ParcelPrivate.h>
+#include <android/os/SamplingProfiler.h>
+#include <android/os/StrictMode.h>
 #include <android++/LogHelper.h>
 #include <android++/TemporaryChange.h>
 
@@ -60,7 +61,7 @@ BinderProxy::~BinderProxy()
 
 bool BinderProxy::transact(int32_t code, Parcel& data, Parcel* reply, int32_t flags)
 {
-    return ApplicationProcess::current().self()->transact(this, code, data, reply, flags);
+    return BinderProvider::sender()->transact(this, code, data, reply, flags);
 }
 
 class LocalBinder final : public BinderProxy, public BinderProvider::Client {
@@ -71,7 +72,7 @@ public:
     bool isLocal() const override;
 
     bool start() override;
-    bool startAtTime(std::chrono::milliseconds) override;
+    bool startAtTime(std::chrono::nanoseconds) override;
     void stop() override;
 
     void close() override;
@@ -113,9 +114,9 @@ bool LocalBinder::start()
     return m_provider->start();
 }
 
-bool LocalBinder::startAtTime(std::chrono::milliseconds uptimeMillis)
+bool LocalBinder::startAtTime(std::chrono::nanoseconds uptimeNanos)
 {
-    return m_provider->startAtTime(uptimeMillis);
+    return m_provider->startAtTime(uptimeNanos);
 }
 
 void LocalBinder::stop()
@@ -137,6 +138,8 @@ bool LocalBinder::transact(int32_t code, Parcel& data, Parcel* reply, int32_t fl
 
 bool LocalBinder::transact(Binder* destination, int32_t code, Parcel& data, Parcel* reply, int32_t flags)
 {
+    // Transactions block until they have been delivered, or replied to unless they are one way.
+    StrictMode::BlockingCall blockingCall(StrictMode::BLOCKING_TRANSACTION, "Binder::transact");
     TemporaryChange<Parcel*> replyChange(m_reply, reply);
     bool ok = m_provider->transact(destination, code, data, flags);
     if (ok)
@@ -163,12 +166,14 @@ void LocalBinder::onTransaction(int32_t code, Parcel& data, intptr_t replyTo, in
 {
     assert(!m_reply || code == Binder::REPLY_TRANSACTION);
 
+    SamplingProfiler::TransactionScope transactionScope(code);
+
     if (replyTo) {
         Parcel reply;
         m_client->onTransaction(code, data, &reply, 0);
         auto sender = Binder::adopt(replyTo);
         if (!sender->transact(Binder::REPLY_TRANSACTION, reply, nullptr, IBinder::FLAG_ONEWAY)) {
-            LOGE("Couldn't send reply");
+            LOGE("%s", "Couldn't send reply");
             return;
         }
     } else {
@@ -61,7 +61,7 @@ public:
     virtual bool isLocal() const { return false; }
 
     virtual bool start() { return false; }
-    virtual bool startAtTime(std::chrono::milliseconds) { return false; }
+    virtual bool startAtTime(std::chrono::nanoseconds) { return false; }
     virtual void stop() { }
 
     virtual void close() { }
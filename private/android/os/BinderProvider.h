@@ -41,12 +41,17 @@ public:
     };
 
     static std::unique_ptr<BinderProvider> create(Client&);
+    // Returns the binder which transactions of adopted binders are sent from on the calling thread.
+    static std::shared_ptr<Binder> sender();
+    // Returns whether the calling process hosts the service objects which other processes import.
+    static bool isRootProcess();
     virtual ~BinderProvider() = default;
 
     virtual intptr_t handle() const = 0;
 
     virtual bool start() = 0;
-    virtual bool startAtTime(std::chrono::milliseconds) = 0;
+    // Fires onTimer() once SystemClock::steadyUptimeNanos() reaches the given time.
+    virtual bool startAtTime(std::chrono::nanoseconds) = 0;
     virtual void stop() = 0;
 
     virtual void close() = 0;
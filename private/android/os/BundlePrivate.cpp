@@ -30,16 +30,47 @@
 namespace android {
 namespace os {
 
+BundlePrivate::BundlePrivate(const BundlePrivate& o)
+    : m_keys(o.m_keys)
+    , m_values(o.m_values)
+    , m_parcelables(o.m_parcelables)
+    , m_messageObjHolder(o.m_messageObjHolder)
+{
+    for (auto& charSequence : o.m_charSequences)
+        m_charSequences[charSequence.first] = std::make_unique<CharSequence>(*charSequence.second);
+}
+
 BundlePrivate& BundlePrivate::getPrivate(Bundle& bundle)
 {
     return *bundle.m_private;
 }
 
+BundlePrivate& BundlePrivate::getMutablePrivate(Bundle& bundle)
+{
+    return bundle.mutablePrivate();
+}
+
 void BundlePrivate::setPrivate(Bundle& bundle, std::unique_ptr<BundlePrivate>&& bundlePrivate)
 {
     bundle.m_private = std::move(bundlePrivate);
 }
 
+void BundlePrivate::recycle(Bundle& bundle)
+{
+    if (bundle.m_private.use_count() != 1) {
+        bundle.m_private.reset();
+        return;
+    }
+
+    bundle.m_private->clear();
+    bundle.m_private->m_messageObjHolder.reset();
+}
+
+bool BundlePrivate::isDetached(Bundle& bundle)
+{
+    return !bundle.m_private;
+}
+
 int32_t BundlePrivate::count()
 {
     return m_keys.size();
@@ -57,11 +57,18 @@ class BundlePrivate {
     friend class Bundle;
 public:
     BundlePrivate() = default;
+    BundlePrivate(const BundlePrivate&);
     ~BundlePrivate() = default;
 
     static BundlePrivate& getPrivate(Bundle&);
+    // Returns the storage of a Bundle for writing, giving the Bundle its own copy first if other Bundles share it.
+    static BundlePrivate& getMutablePrivate(Bundle&);
     static void setPrivate(Bundle&, std::unique_ptr<BundlePrivate>&&);
 
+    // Empties the storage of a Bundle for reuse, or detaches the Bundle from it if other Bundles still share it.
+    static void recycle(Bundle&);
+    static bool isDetached(Bundle&);
+
     int32_t count();
     bool findKey(StringRef key);
     void clear();
@@ -40,6 +40,10 @@ HandlerProvider::HandlerProvider(Handler& handler)
 
 std::shared_ptr<IBinder> HandlerProvider::getBinder(Handler& handler)
 {
+    synchronized (handler) {
+        if (!handler.m_handler)
+            handler.m_handler = std::make_unique<HandlerProvider>(handler);
+    }
     return handler.m_handler->m_binder;
 }
 
@@ -48,21 +52,6 @@ HandlerProvider::~HandlerProvider()
     m_binder->close();
 }
 
-bool HandlerProvider::start()
-{
-    return m_binder->start();
-}
-
-bool HandlerProvider::startAtTime(std::chrono::milliseconds uptimeMillis)
-{
-    return m_binder->startAtTime(uptimeMillis);
-}
-
-void HandlerProvider::stop()
-{
-    m_binder->stop();
-}
-
 void HandlerProvider::onCreate()
 {
 }
@@ -73,7 +62,6 @@ void HandlerProvider::onDestroy()
 
 void HandlerProvider::onTimer()
 {
-    m_handler.performMessages();
 }
 
 void HandlerProvider::onTransaction(int32_t code, Parcel& data, Parcel* reply, int32_t flags)
@@ -81,11 +69,11 @@ void HandlerProvider::onTransaction(int32_t code, Parcel& data, Parcel* reply, i
     if (code != MessageTarget::SEND_MESSAGE)
         return;
 
-    std::shared_ptr<Parcelable> parcelable = ParcelablePrivate::createFromParcel(data, ParcelableCreator::creator<Message>().binaryName);
+    std::shared_ptr<Parcelable> parcelable = ParcelablePrivate::createFromParcel(data, ParcelableCreator::creator<Message>().typeId);
     if (!parcelable)
         return;
 
-    m_handler.receivedMessage(*std::static_pointer_cast<Message>(parcelable));
+    m_handler.receivedMessage(std::move(*std::static_pointer_cast<Message>(parcelable)));
 }
 
 } // namespace os
@@ -39,12 +39,9 @@ public:
     HandlerProvider(Handler&);
     ~HandlerProvider();
 
+    // The binder is created on first use, as only handlers targeted by a Messenger need one.
     static std::shared_ptr<IBinder> getBinder(Handler&);
 
-    bool start();
-    bool startAtTime(std::chrono::milliseconds);
-    void stop();
-
     // Binder::Client
     void onCreate() override;
     void onDestroy() override;
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "LooperMetrics.h"
+
+#include <android/os/Handler.h>
+#include <android/os/SystemClock.h>
+#include <android/os/WorkItem.h>
+#include <android/util/Printer.h>
+#include <android++/LogHelper.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace android {
+namespace os {
+
+static int64_t toMicros(std::chrono::nanoseconds nanos)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(nanos).count();
+}
+
+static std::string callableName(const std::type_info* callableType, intptr_t match)
+{
+    return callableType ? SamplingProfiler::describeCallable(*callableType, match) : std::string("?");
+}
+
+void LooperMetrics::describe(const DispatchRecord& record, char* buffer, size_t size)
+{
+    if (record.isMessage)
+        snprintf(buffer, size, "Handler (%s) {%p} what=%d", record.handlerType->name(), record.handler, static_cast<int32_t>(record.match));
+    else
+        snprintf(buffer, size, "Handler (%s) {%p} callback=%s", record.handlerType->name(), record.handler, callableName(record.callableType, record.match).c_str());
+}
+
+void LooperMetrics::Histogram::record(int64_t value)
+{
+    int32_t bucket = 0;
+    while (bucket < BUCKET_COUNT - 1 && (value >> bucket) > 0)
+        ++bucket;
+
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+    // There is a single writer, so max doesn't need a compare and swap.
+    if (value > m_max.load(std::memory_order_relaxed))
+        m_max.store(value, std::memory_order_relaxed);
+}
+
+void LooperMetrics::Histogram::dump(util::Printer& pw, const char* prefix, const char* name, const char* unit) const
+{
+    char line[256];
+    int64_t count = m_count.load(std::memory_order_relaxed);
+    int64_t sum = m_sum.load(std::memory_order_relaxed);
+    snprintf(line, sizeof(line), "%s%s: count=%lld avg=%.1f%s max=%lld%s", prefix, name, static_cast<long long>(count),
+        count ? static_cast<double>(sum) / count : 0.0, unit, static_cast<long long>(m_max.load(std::memory_order_relaxed)), unit);
+    pw.println(line);
+
+    for (int32_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        int64_t bucketCount = m_buckets[bucket].load(std::memory_order_relaxed);
+        if (!bucketCount)
+            continue;
+
+        long long lower = bucket ? 1ll << (bucket - 1) : 0;
+        long long upper = 1ll << bucket;
+        snprintf(line, sizeof(line), "%s  [%lld, %lld)%s: %lld", prefix, lower, upper, unit, static_cast<long long>(bucketCount));
+        pw.println(line);
+    }
+}
+
+void LooperMetrics::setMessageLogging(util::Printer* printer)
+{
+    m_logging.store(printer, std::memory_order_release);
+    updateObserving();
+}
+
+void LooperMetrics::setSlowLogThresholds(std::chrono::milliseconds slowDispatchThreshold, std::chrono::milliseconds slowDeliveryThreshold)
+{
+    m_slowDispatchThresholdNanos = std::chrono::nanoseconds(slowDispatchThreshold).count();
+    m_slowDeliveryThresholdNanos = std::chrono::nanoseconds(slowDeliveryThreshold).count();
+    updateObserving();
+}
+
+void LooperMetrics::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    updateObserving();
+}
+
+void LooperMetrics::setWatched(bool watched)
+{
+    m_watched = watched;
+    updateObserving();
+}
+
+void LooperMetrics::updateObserving()
+{
+    m_observing = m_enabled || m_watched || m_logging.load() || m_slowDispatchThresholdNanos > 0 || m_slowDeliveryThresholdNanos > 0;
+}
+
+LooperMetrics::DispatchRecord LooperMetrics::dispatchStarting(const WorkItem& item, size_t queueDepth)
+{
+    WorkItemKey key;
+    item.indexKey(WorkItem::MATCH_INDEX, key);
+    DispatchRecord record = { SystemClock::uptimeNanos(), &typeid(item.owner()), key.owner, key.value, item.callableType(), key.isMessage,
+        m_watched.load(std::memory_order_relaxed), SamplingProfiler::isRunning(), SamplingProfiler::Context() };
+
+    if (record.profiled) {
+        SamplingProfiler::Context context;
+        context.handlerType = record.handlerType;
+        context.match = record.match;
+        context.callableType = record.callableType;
+        context.isMessage = record.isMessage;
+        record.previousContext = SamplingProfiler::setContext(context);
+    }
+
+    if (record.watched) {
+        // Keeps these stores after the increment which ended the previous dispatch, as readers rely on.
+        std::atomic_thread_fence(std::memory_order_release);
+        m_currentStartTime.store(record.startTime.count(), std::memory_order_relaxed);
+        m_currentHandlerType.store(record.handlerType, std::memory_order_relaxed);
+        m_currentHandler.store(record.handler, std::memory_order_relaxed);
+        m_currentMatch.store(record.match, std::memory_order_relaxed);
+        m_currentCallableType.store(record.callableType, std::memory_order_relaxed);
+        m_currentIsMessage.store(record.isMessage, std::memory_order_relaxed);
+        m_dispatchGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    if (util::Printer* logging = m_logging.load(std::memory_order_acquire)) {
+        char description[256];
+        char line[sizeof(description) + 32];
+        describe(record, description, sizeof(description));
+        snprintf(line, sizeof(line), ">>>>> Dispatching to %s", description);
+        logging->println(line);
+    }
+
+    // Items posted at the front of the queue have no meaningful fire time.
+    std::chrono::nanoseconds latency = std::chrono::nanoseconds::zero();
+    if (item.fireTime() > std::chrono::nanoseconds::zero())
+        latency = std::max(record.startTime - item.fireTime(), std::chrono::nanoseconds::zero());
+
+    if (m_enabled.load(std::memory_order_relaxed)) {
+        m_queueDepth.record(static_cast<int64_t>(queueDepth));
+        m_queueLatency.record(toMicros(latency));
+    }
+
+    int64_t slowDeliveryThreshold = m_slowDeliveryThresholdNanos.load(std::memory_order_relaxed);
+    if (slowDeliveryThreshold > 0 && latency.count() >= slowDeliveryThreshold) {
+        char description[256];
+        describe(record, description, sizeof(description));
+        LOGW("Slow delivery took %lldms %s", static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(latency).count()), description);
+    }
+
+    return record;
+}
+
+void LooperMetrics::dispatchFinished(const DispatchRecord& record)
+{
+    if (record.watched)
+        m_dispatchGeneration.fetch_add(1, std::memory_order_release);
+    if (record.profiled)
+        SamplingProfiler::setContext(record.previousContext);
+
+    std::chrono::nanoseconds dispatchTime = SystemClock::uptimeNanos() - record.startTime;
+
+    if (m_enabled.load(std::memory_order_relaxed)) {
+        m_dispatchTime.record(toMicros(dispatchTime));
+        recordSite(record, dispatchTime);
+    }
+
+    int64_t slowDispatchThreshold = m_slowDispatchThresholdNanos.load(std::memory_order_relaxed);
+    if (slowDispatchThreshold > 0 && dispatchTime.count() >= slowDispatchThreshold) {
+        char description[256];
+        describe(record, description, sizeof(description));
+        LOGW("Slow dispatch took %lldms %s", static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(dispatchTime).count()), description);
+    }
+
+    if (util::Printer* logging = m_logging.load(std::memory_order_acquire)) {
+        char description[256];
+        char line[sizeof(description) + 32];
+        describe(record, description, sizeof(description));
+        snprintf(line, sizeof(line), "<<<<< Finished to %s", description);
+        logging->println(line);
+    }
+}
+
+bool LooperMetrics::currentDispatch(DispatchRecord& record, uint64_t& generation) const
+{
+    generation = m_dispatchGeneration.load(std::memory_order_acquire);
+    if (!(generation & 1))
+        return false;
+
+    record.startTime = std::chrono::nanoseconds(m_currentStartTime.load(std::memory_order_relaxed));
+    record.handlerType = m_currentHandlerType.load(std::memory_order_relaxed);
+    record.handler = m_currentHandler.load(std::memory_order_relaxed);
+    record.match = m_currentMatch.load(std::memory_order_relaxed);
+    record.callableType = m_currentCallableType.load(std::memory_order_relaxed);
+    record.isMessage = m_currentIsMessage.load(std::memory_order_relaxed);
+    record.watched = true;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return m_dispatchGeneration.load(std::memory_order_relaxed) == generation;
+}
+
+void LooperMetrics::recordSite(const DispatchRecord& record, std::chrono::nanoseconds dispatchTime)
+{
+    size_t hash = std::hash<const void*>()(record.handlerType) ^ (std::hash<intptr_t>()(record.match) * 31 + record.isMessage);
+    for (size_t probe = 0; probe < SITE_COUNT; ++probe) {
+        Site& site = m_sites[(hash + probe) % SITE_COUNT];
+        const std::type_info* handlerType = site.handlerType.load(std::memory_order_relaxed);
+        if (!handlerType) {
+            site.match.store(record.match, std::memory_order_relaxed);
+            site.callableType.store(record.callableType, std::memory_order_relaxed);
+            site.isMessage.store(record.isMessage, std::memory_order_relaxed);
+            site.count.store(1, std::memory_order_relaxed);
+            site.totalNanos.store(dispatchTime.count(), std::memory_order_relaxed);
+            site.handlerType.store(record.handlerType, std::memory_order_release);
+            return;
+        }
+
+        if (handlerType == record.handlerType && site.match.load(std::memory_order_relaxed) == record.match
+            && site.callableType.load(std::memory_order_relaxed) == record.callableType
+            && site.isMessage.load(std::memory_order_relaxed) == record.isMessage) {
+            site.count.fetch_add(1, std::memory_order_relaxed);
+            site.totalNanos.fetch_add(dispatchTime.count(), std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    m_unrecordedSiteCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LooperMetrics::dump(util::Printer& pw, const char* prefix) const
+{
+    char line[512];
+    if (!m_enabled.load(std::memory_order_relaxed)) {
+        snprintf(line, sizeof(line), "%sDispatch metrics are disabled", prefix);
+        pw.println(line);
+        return;
+    }
+
+    std::string innerPrefix = std::string(prefix) + "  ";
+    m_queueLatency.dump(pw, innerPrefix.c_str(), "Time in queue", "us");
+    m_dispatchTime.dump(pw, innerPrefix.c_str(), "Dispatch time", "us");
+    m_queueDepth.dump(pw, innerPrefix.c_str(), "Queue depth", "");
+
+    struct SiteSnapshot {
+        const std::type_info* handlerType;
+        intptr_t match;
+        const std::type_info* callableType;
+        bool isMessage;
+        int64_t count;
+        int64_t totalNanos;
+    };
+
+    std::vector<SiteSnapshot> sites;
+    for (const Site& site : m_sites) {
+        const std::type_info* handlerType = site.handlerType.load(std::memory_order_acquire);
+        if (handlerType)
+            sites.push_back({ handlerType, site.match.load(std::memory_order_relaxed), site.callableType.load(std::memory_order_relaxed), site.isMessage.load(std::memory_order_relaxed),
+                site.count.load(std::memory_order_relaxed), site.totalNanos.load(std::memory_order_relaxed) });
+    }
+    std::sort(sites.begin(), sites.end(), [] (const SiteSnapshot& lhs, const SiteSnapshot& rhs) {
+        return lhs.count > rhs.count;
+    });
+
+    snprintf(line, sizeof(line), "%sDispatches by site:", innerPrefix.c_str());
+    pw.println(line);
+    for (const SiteSnapshot& site : sites) {
+        double averageMicros = static_cast<double>(site.totalNanos) / site.count / 1000;
+        if (site.isMessage)
+            snprintf(line, sizeof(line), "%s  Handler (%s) what=%d: count=%lld avg=%.1fus", innerPrefix.c_str(), site.handlerType->name(),
+                static_cast<int32_t>(site.match), static_cast<long long>(site.count), averageMicros);
+        else
+            snprintf(line, sizeof(line), "%s  Handler (%s) callback=%s: count=%lld avg=%.1fus", innerPrefix.c_str(), site.handlerType->name(),
+                callableName(site.callableType, site.match).c_str(), static_cast<long long>(site.count), averageMicros);
+        pw.println(line);
+    }
+
+    int64_t unrecordedSiteCount = m_unrecordedSiteCount.load(std::memory_order_relaxed);
+    if (unrecordedSiteCount) {
+        snprintf(line, sizeof(line), "%s  (%lld dispatches from other sites)", innerPrefix.c_str(), static_cast<long long>(unrecordedSiteCount));
+        pw.println(line);
+    }
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <android/os/SamplingProfiler.h>
+#include <java/lang.h>
+
+#include <atomic>
+#include <typeinfo>
+
+namespace android {
+namespace util {
+class Printer;
+}
+namespace os {
+
+class WorkItem;
+
+// Dispatch logging and statistics of a looper. Dispatches are recorded on the looper thread only, while settings
+// and dumps may come from any thread, so everything shared is atomic and nothing takes a lock.
+class LooperMetrics final {
+    NONCOPYABLE(LooperMetrics);
+public:
+    // Counts values into power of two buckets. Bucket 0 holds values below 1, bucket i those in [2^(i-1), 2^i).
+    class Histogram final {
+    public:
+        static const int32_t BUCKET_COUNT = 32;
+
+        void record(int64_t value);
+        void dump(util::Printer&, const char* prefix, const char* name, const char* unit) const;
+
+    private:
+        std::atomic<int64_t> m_buckets[BUCKET_COUNT] {};
+        std::atomic<int64_t> m_count { 0 };
+        std::atomic<int64_t> m_sum { 0 };
+        std::atomic<int64_t> m_max { 0 };
+    };
+
+    // What dispatchFinished() needs to know about an item, taken before it runs since running may destroy its owner.
+    struct DispatchRecord {
+        std::chrono::nanoseconds startTime;
+        const std::type_info* handlerType;
+        const void* handler;
+        intptr_t match;
+        // The type of the callable a callback runs, or null for messages.
+        const std::type_info* callableType;
+        bool isMessage;
+        // Whether the dispatch was published for the watchdog.
+        bool watched;
+        // Whether the dispatch was set as the context of samples, and the context it replaced.
+        bool profiled;
+        SamplingProfiler::Context previousContext;
+    };
+
+    LooperMetrics() = default;
+    ~LooperMetrics() = default;
+
+    // Returns true if dispatches are being logged, measured or profiled. This is the only cost per item when they aren't.
+    bool isObserving() const { return m_observing.load(std::memory_order_relaxed) || SamplingProfiler::isRunning(); }
+
+    void setMessageLogging(util::Printer*);
+    void setSlowLogThresholds(std::chrono::milliseconds slowDispatchThreshold, std::chrono::milliseconds slowDeliveryThreshold);
+    void setEnabled(bool);
+    // Publishes the item being dispatched, so that the watchdog can tell from its own thread how long it has been running.
+    void setWatched(bool);
+
+    DispatchRecord dispatchStarting(const WorkItem&, size_t queueDepth);
+    void dispatchFinished(const DispatchRecord&);
+
+    // Returns false if no published dispatch is in progress. Otherwise fills in its record, and a generation which
+    // differs for every dispatch.
+    bool currentDispatch(DispatchRecord&, uint64_t& generation) const;
+
+    static void describe(const DispatchRecord&, char* buffer, size_t size);
+
+    void dump(util::Printer&, const char* prefix) const;
+
+private:
+    // Dispatch counts per handler class and what or callback. Slots are claimed by the looper thread and published
+    // through handlerType.
+    struct Site {
+        std::atomic<const std::type_info*> handlerType { nullptr };
+        std::atomic<intptr_t> match { 0 };
+        std::atomic<const std::type_info*> callableType { nullptr };
+        std::atomic<bool> isMessage { false };
+        std::atomic<int64_t> count { 0 };
+        std::atomic<int64_t> totalNanos { 0 };
+    };
+
+    static const size_t SITE_COUNT = 256;
+
+    void updateObserving();
+    void recordSite(const DispatchRecord&, std::chrono::nanoseconds dispatchTime);
+
+    std::atomic<bool> m_observing { false };
+    std::atomic<bool> m_enabled { false };
+    std::atomic<bool> m_watched { false };
+    std::atomic<util::Printer*> m_logging { nullptr };
+    std::atomic<int64_t> m_slowDispatchThresholdNanos { 0 };
+    std::atomic<int64_t> m_slowDeliveryThresholdNanos { 0 };
+
+    Histogram m_queueLatency;
+    Histogram m_dispatchTime;
+    Histogram m_queueDepth;
+    Site m_sites[SITE_COUNT];
+    std::atomic<int64_t> m_unrecordedSiteCount { 0 };
+
+    // The published dispatch, valid while the generation is odd. Readers check that the generation didn't change
+    // while they copied it.
+    std::atomic<uint64_t> m_dispatchGeneration { 0 };
+    std::atomic<int64_t> m_currentStartTime { 0 };
+    std::atomic<const std::type_info*> m_currentHandlerType { nullptr };
+    std::atomic<const void*> m_currentHandler { nullptr };
+    std::atomic<intptr_t> m_currentMatch { 0 };
+    std::atomic<const std::type_info*> m_currentCallableType { nullptr };
+    std::atomic<bool> m_currentIsMessage { false };
+};
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MessagePool.h"
+
+#include <android/os/BundlePrivate.h>
+
+#include <atomic>
+
+namespace android {
+namespace os {
+
+static std::atomic<Bundle*> pool[MessagePool::MAX_POOL_SIZE];
+static std::atomic<int64_t> poolHits;
+static std::atomic<int64_t> poolMisses;
+
+static Bundle* takeFromPool()
+{
+    for (auto& slot : pool) {
+        if (!slot.load(std::memory_order_relaxed))
+            continue;
+        if (Bundle* bundle = slot.exchange(nullptr, std::memory_order_acquire))
+            return bundle;
+    }
+
+    return nullptr;
+}
+
+static bool returnToPool(Bundle* bundle)
+{
+    for (auto& slot : pool) {
+        Bundle* empty = nullptr;
+        if (!slot.load(std::memory_order_relaxed)
+            && slot.compare_exchange_strong(empty, bundle, std::memory_order_release, std::memory_order_relaxed))
+            return true;
+    }
+
+    return false;
+}
+
+Bundle* MessagePool::obtainData()
+{
+    Bundle* bundle = takeFromPool();
+    if (!bundle) {
+        poolMisses.fetch_add(1, std::memory_order_relaxed);
+        return new Bundle;
+    }
+
+    if (BundlePrivate::isDetached(*bundle)) {
+        poolMisses.fetch_add(1, std::memory_order_relaxed);
+        BundlePrivate::setPrivate(*bundle, std::make_unique<BundlePrivate>());
+    } else {
+        poolHits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return bundle;
+}
+
+Bundle* MessagePool::obtainData(const Bundle& orig)
+{
+    // A copy shares the storage of orig, so a pooled Bundle would have its storage thrown away. The pool is left to
+    // obtainData(), which reuses it.
+    return new Bundle(orig);
+}
+
+void MessagePool::recycleData(Bundle* bundle)
+{
+    if (!bundle)
+        return;
+
+    BundlePrivate::recycle(*bundle);
+    if (!returnToPool(bundle))
+        delete bundle;
+}
+
+int64_t MessagePool::hitCount()
+{
+    return poolHits.load(std::memory_order_relaxed);
+}
+
+int64_t MessagePool::missCount()
+{
+    return poolMisses.load(std::memory_order_relaxed);
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <android/os/Bundle.h>
+
+namespace android {
+namespace os {
+
+// The global pool behind Message::obtain() and Message::recycle(). Messages are values, so what is pooled is
+// the Bundle storage they carry. The pool is a bounded array of slots which are claimed and released with
+// atomic exchanges, so it never blocks and doesn't suffer from ABA like a linked free list would.
+class MessagePool final {
+public:
+    static const int32_t MAX_POOL_SIZE = 50;
+
+    // Returns an empty Bundle, reusing recycled storage if possible.
+    static Bundle* obtainData();
+    // Returns a Bundle sharing the contents of orig. It has no storage of its own to reuse, so it bypasses the pool.
+    static Bundle* obtainData(const Bundle& orig);
+    // Returns a Bundle to the pool, or deletes it if the pool is full.
+    static void recycleData(Bundle*);
+
+    static int64_t hitCount();
+    static int64_t missCount();
+};
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MessageQueueProvider.h"
+
+#include <android/os/MessageQueue.h>
+
+namespace android {
+namespace os {
+
+MessageQueueProvider::MessageQueueProvider(MessageQueue& queue)
+    : m_queue(queue)
+    , m_binder(Binder::create(*this))
+{
+}
+
+MessageQueueProvider::~MessageQueueProvider()
+{
+    m_binder->close();
+}
+
+bool MessageQueueProvider::start()
+{
+    return m_binder->start();
+}
+
+bool MessageQueueProvider::startAtTime(std::chrono::nanoseconds uptimeNanos)
+{
+    return m_binder->startAtTime(uptimeNanos);
+}
+
+void MessageQueueProvider::stop()
+{
+    m_binder->stop();
+}
+
+void MessageQueueProvider::onCreate()
+{
+}
+
+void MessageQueueProvider::onDestroy()
+{
+}
+
+void MessageQueueProvider::onTimer()
+{
+    m_queue.dispatchWorkItems();
+}
+
+void MessageQueueProvider::onTransaction(int32_t code, Parcel& data, Parcel* reply, int32_t flags)
+{
+}
+
+} // namespace os
+} // namespace android
@@ -39,7 +39,7 @@ public:
 
     std::shared_ptr<IBinder> binder() const override;
 
-    void send(Message&) override;
+    void send(Message&&) override;
 
 private:
     std::shared_ptr<Handler> m_target;
@@ -59,9 +59,9 @@ std::shared_ptr<IBinder> HandlerMessageTarget::binder() const
     return HandlerProvider::getBinder(*m_target);
 }
 
-void HandlerMessageTarget::send(Message& message)
+void HandlerMessageTarget::send(Message&& message)
 {
-    m_target->sendMessage(message);
+    m_target->sendMessage(std::move(message));
 }
 
 std::unique_ptr<MessageTarget> MessageTarget::create(std::passed_ptr<Handler> target)
@@ -76,7 +76,7 @@ public:
 
     std::shared_ptr<IBinder> binder() const override;
 
-    void send(Message&) override;
+    void send(Message&&) override;
 
 private:
     std::shared_ptr<IBinder> m_target;
@@ -96,7 +96,7 @@ std::shared_ptr<IBinder> BinderMessageTarget::binder() const
     return m_target;
 }
 
-void BinderMessageTarget::send(Message& message)
+void BinderMessageTarget::send(Message&& message)
 {
     Parcel data;
     message.writeToParcel(data, Parcelable::PARCELABLE_WRITE_RETURN_VALUE);
@@ -43,7 +43,7 @@ public:
 
     virtual std::shared_ptr<IBinder> binder() const = 0;
 
-    virtual void send(Message&) = 0;
+    virtual void send(Message&&) = 0;
 
 protected:
     MessageTarget() = default;
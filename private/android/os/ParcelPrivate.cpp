@@ -29,6 +29,10 @@
 #include "ServiceObject.h"
 #include <android++/LogHelper.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <string.h>
+
 using namespace java::io;
 
 namespace android {
@@ -43,6 +47,8 @@ ParcelPrivate::ParcelPrivate(Parcel& parcel)
 
 ParcelPrivate::~ParcelPrivate()
 {
+    releaseBorrowed();
+
     if (m_sent)
         return;
 
@@ -53,11 +59,32 @@ ParcelPrivate::~ParcelPrivate()
         object->deref();
 }
 
-void ParcelPrivate::initializeWithCopy(Parcel& parcel, int8_t* data, size_t length)
+std::shared_ptr<ParcelPrivate> ParcelPrivate::initializeBorrowed(Parcel& parcel, const int8_t* data, size_t length, std::function<void ()>&& release)
+{
+    ParcelPrivate& parcelPrivate = ParcelPrivate::getPrivate(parcel);
+    assert(!parcelPrivate.m_size);
+    parcelPrivate.releaseBorrowed();
+    parcelPrivate.m_buffer.reset();
+    parcelPrivate.m_data = const_cast<int8_t*>(data);
+    parcelPrivate.m_size = length;
+    parcelPrivate.m_capacity = 0;
+    parcelPrivate.m_borrowed = true;
+    parcelPrivate.m_release = std::move(release);
+    parcelPrivate.reset();
+
+    // Arrays are read in place at offsets aligned from the start of the data, so the start must suit any type.
+    if (reinterpret_cast<uintptr_t>(data) % alignof(std::max_align_t))
+        parcelPrivate.reserve(length);
+
+    return parcel.m_private;
+}
+
+void ParcelPrivate::endBorrowing(Parcel& parcel, const std::shared_ptr<ParcelPrivate>& parcelPrivate)
 {
-    std::vector<int8_t>& buffer = ParcelPrivate::getPrivate(parcel).m_buffer;
-    buffer.insert(buffer.end(), data, data + length);
-    ParcelPrivate::getPrivate(parcel).reset();
+    // Neither the caller's reference nor the parcel's, unless it was moved from, outlive the borrowed data.
+    long ownReferences = parcel.m_private == parcelPrivate ? 2 : 1;
+    if (parcelPrivate->m_borrowed && parcelPrivate.use_count() > ownReferences)
+        parcelPrivate->reserve(parcelPrivate->m_size);
 }
 
 ParcelPrivate& ParcelPrivate::getPrivate(Parcel& parcel)
@@ -72,12 +99,36 @@ void ParcelPrivate::setPrivate(Parcel& parcel, std::unique_ptr<ParcelPrivate>&&
 
 size_t ParcelPrivate::size() const
 {
-    return m_buffer.size();
+    return m_size;
+}
+
+size_t ParcelPrivate::capacity() const
+{
+    return m_capacity;
+}
+
+void ParcelPrivate::reserve(size_t newCapacity)
+{
+    // Borrowed data is never written to, so it is copied over to a buffer of the parcel first.
+    if (newCapacity <= m_capacity && !m_borrowed)
+        return;
+
+    newCapacity = std::max(newCapacity, m_size);
+    // Readers point into the buffer, so they start over from the new one.
+    size_t readOffset = ByteReader::position();
+    std::unique_ptr<int8_t[]> buffer(new int8_t[newCapacity]);
+    if (m_size)
+        memcpy(buffer.get(), m_data, m_size);
+    m_buffer = std::move(buffer);
+    m_data = m_buffer.get();
+    m_capacity = newCapacity;
+    releaseBorrowed();
+    ByteReader::seek(readOffset);
 }
 
 int8_t* ParcelPrivate::data()
 {
-    return m_buffer.data();
+    return m_data;
 }
 
 void ParcelPrivate::reset()
@@ -114,7 +165,20 @@ void ParcelPrivate::hold(ServiceObject* object)
 
 void ParcelPrivate::resize(size_t newSize)
 {
-    m_buffer.resize(newSize);
+    assert(newSize <= m_capacity && !m_borrowed);
+    m_size = newSize;
+}
+
+void ParcelPrivate::releaseBorrowed()
+{
+    if (!m_borrowed)
+        return;
+
+    m_borrowed = false;
+    if (auto release = std::move(m_release)) {
+        m_release = nullptr;
+        release();
+    }
 }
 
 } // namespace os
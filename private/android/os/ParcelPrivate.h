@@ -42,12 +42,19 @@ class ParcelPrivate : public java::io::ByteReader, public java::io::ByteWriter
 public:
     ParcelPrivate(Parcel&);
     ~ParcelPrivate();
-    static void initializeWithCopy(Parcel&, int8_t* data, size_t length);
+    // Makes the parcel read data owned elsewhere in place. release is invoked once the parcel no longer refers to it.
+    // Data which isn't aligned for std::max_align_t is copied right away. Returns the private to end borrowing on.
+    static std::shared_ptr<ParcelPrivate> initializeBorrowed(Parcel&, const int8_t* data, size_t length, std::function<void ()>&& release = nullptr);
+    // Called before borrowed data goes away, with the parcel and the private initializeBorrowed() returned for it.
+    // Copies the data if other parcels still refer to it, including ones the parcel was moved to meanwhile.
+    static void endBorrowing(Parcel&, const std::shared_ptr<ParcelPrivate>&);
 
     static ParcelPrivate& getPrivate(Parcel&);
     static void setPrivate(Parcel&, std::unique_ptr<ParcelPrivate>&&);
 
     size_t size() const override;
+    size_t capacity() const override;
+    void reserve(size_t) override;
     int8_t* data() override;
 
     void reset();
@@ -61,10 +68,18 @@ public:
 
 private:
     void resize(size_t) override;
+    void releaseBorrowed();
 
     Parcel& m_parcel;
     bool m_sent { false };
-    std::vector<int8_t> m_buffer;
+    // The buffer isn't a std::vector, as growing one would clear the bytes which are about to be written.
+    std::unique_ptr<int8_t[]> m_buffer;
+    // Either m_buffer or borrowed data, which has no capacity so that the first write copies it.
+    int8_t* m_data { nullptr };
+    bool m_borrowed { false };
+    std::function<void ()> m_release;
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
     std::shared_ptr<Binder> m_origin;
     std::unordered_set<intptr_t> m_handles;
     std::unordered_set<ServiceObject*> m_serviceObjects;
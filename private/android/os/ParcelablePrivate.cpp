@@ -26,33 +26,100 @@
 #include "ParcelablePrivate.h"
 
 #include <android/os/ParcelPrivate.h>
+#include <android++/LogHelper.h>
+#include <android++/StringConversion.h>
+
+#include <atomic>
+#include <mutex>
 
 namespace android {
 namespace os {
 
-static std::shared_ptr<Parcelable> readFromParcel(Parcel& source, StringRef binaryName)
+struct ParcelableType {
+    int32_t typeId;
+    String binaryName;
+    Parcelable::Creator& creator;
+};
+
+// Open addressed by type id, so that finding the creator of a parcelable being read is an array index. Types are
+// only ever added, which lets readers go without a lock.
+static const size_t typeTableSize = 1024;
+static std::atomic<ParcelableType*> typeTable[typeTableSize];
+
+static std::mutex& typeTableLock()
+{
+    static std::mutex lock;
+    return lock;
+}
+
+int32_t ParcelablePrivate::typeId(StringRef binaryName)
+{
+    // FNV-1a, over the characters rather than the bytes as wchar_t differs in size across platforms.
+    uint32_t hash = 2166136261u;
+    for (auto c : binaryName) {
+        hash ^= static_cast<uint32_t>(c);
+        hash *= 16777619u;
+    }
+    return static_cast<int32_t>(hash);
+}
+
+void ParcelablePrivate::registerType(int32_t typeId, StringRef binaryName, Parcelable::Creator& creator)
+{
+    std::lock_guard<std::mutex> lock(typeTableLock());
+    for (size_t i = 0; i < typeTableSize; ++i) {
+        auto& slot = typeTable[(static_cast<uint32_t>(typeId) + i) % typeTableSize];
+        ParcelableType* type = slot.load(std::memory_order_relaxed);
+        if (!type) {
+            slot.store(new ParcelableType { typeId, binaryName, creator }, std::memory_order_release);
+            return;
+        }
+        if (type->typeId != typeId)
+            continue;
+        if (type->binaryName != binaryName)
+            LOGA("Parcelable %s has the type id of %s", std::ws2s(binaryName).c_str(), std::ws2s(type->binaryName).c_str());
+        return;
+    }
+
+    LOGA("%s", "Too many parcelable types");
+}
+
+static ParcelableType* findType(int32_t typeId)
 {
-    auto creatorClass = ClassLoader::getSystemClassLoader().findClass(binaryName);
-    auto creator = std::static_pointer_cast<Parcelable::Creator>(creatorClass->newInstance());
-    return creator->createFromParcel(source);
+    for (size_t i = 0; i < typeTableSize; ++i) {
+        ParcelableType* type = typeTable[(static_cast<uint32_t>(typeId) + i) % typeTableSize].load(std::memory_order_acquire);
+        if (!type || type->typeId == typeId)
+            return type;
+    }
+    return nullptr;
+}
+
+static std::shared_ptr<Parcelable> readFromParcel(Parcel& source, int32_t typeId)
+{
+    ParcelableType* type = findType(typeId);
+    if (!type) {
+        LOGE("Unknown parcelable type %08x", typeId);
+        return nullptr;
+    }
+
+    return type->creator.createFromParcel(source);
 }
 
 std::shared_ptr<Parcelable> ParcelablePrivate::createFromParcel(Parcel& source)
 {
-    String creatorBinaryName;
-    source >> creatorBinaryName;
-    return readFromParcel(source, creatorBinaryName);
+    int32_t creatorTypeId = 0;
+    source >> creatorTypeId;
+    return readFromParcel(source, creatorTypeId);
 }
 
-std::shared_ptr<Parcelable> ParcelablePrivate::createFromParcel(Parcel& source, StringRef binaryName)
+std::shared_ptr<Parcelable> ParcelablePrivate::createFromParcel(Parcel& source, int32_t typeId)
 {
-    String creatorBinaryName;
-    source >> creatorBinaryName;
-    if (binaryName != creatorBinaryName) {
+    int32_t creatorTypeId = 0;
+    source >> creatorTypeId;
+    if (typeId != creatorTypeId) {
         ParcelPrivate::getPrivate(source).reset();
         return nullptr;
     }
-    return readFromParcel(source, creatorBinaryName);
+    return readFromParcel(source, creatorTypeId);
 }
 
 } // namespace os
@@ -33,17 +33,28 @@ namespace os {
 class ParcelablePrivate final {
 public:
     static std::shared_ptr<Parcelable> createFromParcel(Parcel& source);
-    static std::shared_ptr<Parcelable> createFromParcel(Parcel& source, StringRef binaryName);
+    // Returns null, leaving the parcel unread, unless the parcelable written is of the given type.
+    static std::shared_ptr<Parcelable> createFromParcel(Parcel& source, int32_t typeId);
+
+    // Parcelables are tagged with a hash of the binary name of their creator, which is the same in every process.
+    static int32_t typeId(StringRef binaryName);
+    // Only the first creator of a type is kept, which is its CREATOR.
+    static void registerType(int32_t typeId, StringRef binaryName, Parcelable::Creator&);
 };
 
 class ParcelableCreator : public Parcelable::Creator {
 protected:
+    // Creators are singletons, so the class of a creator hands out the CREATOR rather than a new instance.
     template<typename T>
-    ParcelableCreator(T*, String&& packageName, String&& name)
+    ParcelableCreator(T* creator, String&& packageName, String&& name)
         : binaryName(packageName + L'.' + name)
+        , typeId(ParcelablePrivate::typeId(binaryName))
     {
         ClassLoader::getSystemClassLoader().definePackage(String(packageName), String(), String(), String(), String(), String(), String(), URL());
-        ClassLoader::getSystemClassLoader().resolveClass(std::make_shared<java::lang::ClassT<T>>(std::move(packageName), std::move(name)));
+        ClassLoader::getSystemClassLoader().resolveClass(std::make_shared<java::lang::ClassT<T>>(std::move(packageName), std::move(name), [creator] {
+            return std::static_pointer_cast<void>(std::ref_ptr(*creator));
+        }));
+        ParcelablePrivate::registerType(typeId, binaryName, *creator);
     }
 
 public:
@@ -54,10 +65,11 @@ public:
 
     template<typename T> static void writeToParcel(T&, Parcel& dest)
     {
-        dest << ParcelableCreator::creator<T>().binaryName;
+        dest << ParcelableCreator::creator<T>().typeId;
     }
 
     const String binaryName;
+    const int32_t typeId;
 };
 
 } // namespace os
@@ -30,6 +30,8 @@
 namespace android {
 namespace os {
 
+class PlatformEvent;
+
 class PlatformEventPrivate final {
     friend class PlatformEvent;
     friend class WaitCallback;
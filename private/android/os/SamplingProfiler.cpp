@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SamplingProfiler.h"
+
+#include <android/os/StrictMode.h>
+#include <android++/CompilerMacros.h>
+#include <android++/LogHelper.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+
+#if COMPILER(GCC) || COMPILER(CLANG)
+// Samples read the context from a signal handler, where the lazy allocation of the dynamic TLS model isn't safe.
+#define SIGNAL_SAFE_THREAD_LOCAL thread_local __attribute__((tls_model("initial-exec")))
+#else
+#define SIGNAL_SAFE_THREAD_LOCAL thread_local
+#endif
+
+namespace android {
+namespace os {
+
+const int32_t SamplingProfiler::MAX_FRAMES;
+std::atomic<bool> SamplingProfiler::s_running { false };
+
+static SIGNAL_SAFE_THREAD_LOCAL SamplingProfiler::Context threadContext;
+
+// The buffer of the current run, shared with the signal handler.
+static std::unique_ptr<uint8_t[]> sampleBuffer;
+static size_t sampleCapacity;
+static std::atomic<size_t> nextSample { 0 };
+static std::atomic<int64_t> droppedSampleCount { 0 };
+// Signal handlers which are recording, so that stop() doesn't take the buffer away from under them.
+static std::atomic<int32_t> activeRecorders { 0 };
+
+static std::mutex& profilerLock()
+{
+    static std::mutex lock;
+    return lock;
+}
+
+static std::string tracePath;
+
+SamplingProfiler::TransactionScope::TransactionScope(int32_t code)
+    : m_running(SamplingProfiler::isRunning())
+{
+    if (!m_running)
+        return;
+
+    Context context;
+    context.inTransaction = true;
+    context.transactionCode = code;
+    m_previousContext = setContext(context);
+}
+
+SamplingProfiler::TransactionScope::~TransactionScope()
+{
+    if (m_running)
+        setContext(m_previousContext);
+}
+
+SamplingProfiler::Context SamplingProfiler::setContext(const Context& context)
+{
+    Context previousContext = threadContext;
+    // A sample may interrupt the copy, and see a context which is partly the new one. Only that sample is affected.
+    threadContext = context;
+    return previousContext;
+}
+
+bool SamplingProfiler::start(const std::string& path, size_t bufferSize, std::chrono::microseconds interval)
+{
+    std::lock_guard<std::mutex> lock(profilerLock());
+    if (s_running) {
+        LOGW("%s", "Sampling is already running");
+        return false;
+    }
+
+    sampleCapacity = bufferSize / sizeof(Sample);
+    if (!sampleCapacity || interval <= std::chrono::microseconds::zero()) {
+        LOGE("Invalid sampling buffer size %zu or interval %lldus", bufferSize, static_cast<long long>(interval.count()));
+        return false;
+    }
+
+    sampleBuffer.reset(new uint8_t[sampleCapacity * sizeof(Sample)]);
+    nextSample = 0;
+    droppedSampleCount = 0;
+    tracePath = path;
+
+    s_running = true;
+    if (!platformStartSampling(interval)) {
+        s_running = false;
+        sampleBuffer.reset();
+        return false;
+    }
+    return true;
+}
+
+void SamplingProfiler::stop()
+{
+    std::lock_guard<std::mutex> lock(profilerLock());
+    if (!s_running)
+        return;
+
+    s_running = false;
+    platformStopSampling();
+    while (activeRecorders.load())
+        std::this_thread::yield();
+
+    size_t sampleCount = std::min(nextSample.load(), sampleCapacity);
+    const Sample* samples = reinterpret_cast<const Sample*>(sampleBuffer.get());
+    if (!writeTrace(tracePath, samples, sampleCount, droppedSampleCount.load()))
+        LOGE("Couldn't write trace to %s", tracePath.c_str());
+    sampleBuffer.reset();
+}
+
+void SamplingProfiler::recordSample(void* const* frames, int32_t frameCount)
+{
+    activeRecorders.fetch_add(1);
+    if (s_running.load()) {
+        size_t index = nextSample.fetch_add(1, std::memory_order_relaxed);
+        if (index < sampleCapacity) {
+            Sample& sample = reinterpret_cast<Sample*>(sampleBuffer.get())[index];
+            sample.context = threadContext;
+            sample.frameCount = std::min(frameCount, MAX_FRAMES);
+            for (int32_t i = 0; i < sample.frameCount; ++i)
+                sample.frames[i] = frames[i];
+        } else {
+            droppedSampleCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    activeRecorders.fetch_sub(1);
+}
+
+std::string SamplingProfiler::describeCallable(const std::type_info& callableType, intptr_t match)
+{
+    if (callableType == typeid(void(*)()))
+        return platformSymbolize(reinterpret_cast<const void*>(match));
+    return platformDemangle(callableType.name());
+}
+
+const std::string& SamplingProfiler::symbolize(const void* address, SymbolCache& symbols)
+{
+    auto symbol = symbols.find(address);
+    if (symbol == symbols.end())
+        symbol = symbols.emplace(address, platformSymbolize(address)).first;
+    return symbol->second;
+}
+
+std::string SamplingProfiler::describe(const Context& context, SymbolCache& symbols)
+{
+    char description[512];
+    if (context.inTransaction) {
+        snprintf(description, sizeof(description), "Binder transaction code=%d", context.transactionCode);
+        return description;
+    }
+
+    if (!context.handlerType)
+        return std::string();
+
+    std::string handlerName = platformDemangle(context.handlerType->name());
+    if (context.isMessage) {
+        snprintf(description, sizeof(description), "Handler (%s) what=%d", handlerName.c_str(), static_cast<int32_t>(context.match));
+        return description;
+    }
+
+    std::string callableName;
+    if (!context.callableType)
+        callableName = "?";
+    else if (*context.callableType == typeid(void(*)()))
+        callableName = symbolize(reinterpret_cast<const void*>(context.match), symbols);
+    else
+        callableName = platformDemangle(context.callableType->name());
+
+    snprintf(description, sizeof(description), "Handler (%s) callback %s", handlerName.c_str(), callableName.c_str());
+    return description;
+}
+
+bool SamplingProfiler::writeTrace(const std::string& path, const Sample* samples, size_t sampleCount, int64_t droppedCount)
+{
+    StrictMode::BlockingCall blockingCall(StrictMode::DISK_WRITE, "SamplingProfiler::writeTrace");
+
+    // Identical stacks in the same context are folded into one line, root first, as flame graph tools expect.
+    SymbolCache symbols;
+    std::map<std::string, int64_t> stacks;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        const Sample& sample = samples[i];
+        std::string stack = describe(sample.context, symbols);
+        for (int32_t frame = sample.frameCount - 1; frame >= 0; --frame) {
+            if (!stack.empty())
+                stack += ';';
+            stack += symbolize(sample.frames[frame], symbols);
+        }
+        ++stacks[stack];
+    }
+
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file)
+        return false;
+
+    for (auto& stack : stacks)
+        fprintf(file, "%s %lld\n", stack.first.c_str(), static_cast<long long>(stack.second));
+    fclose(file);
+
+    if (droppedCount)
+        LOGW("The sampling buffer was full, %lld samples were dropped", static_cast<long long>(droppedCount));
+    return true;
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <java/lang.h>
+
+#include <atomic>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace android {
+namespace os {
+
+// Samples the stacks of the threads which use CPU time, and attributes each sample to the message or binder
+// transaction its thread was handling. Samples are taken from a signal handler, so recording one only copies it
+// into a buffer allocated up front.
+class SamplingProfiler final {
+public:
+    static const int32_t MAX_FRAMES = 48;
+
+    // What a thread is handling, as recorded with its samples.
+    struct Context {
+        const std::type_info* handlerType { nullptr };
+        intptr_t match { 0 };
+        const std::type_info* callableType { nullptr };
+        bool isMessage { false };
+        bool inTransaction { false };
+        int32_t transactionCode { 0 };
+    };
+
+    // Marks the current thread as handling a binder transaction.
+    class TransactionScope final {
+        NONCOPYABLE(TransactionScope);
+    public:
+        TransactionScope(int32_t code);
+        ~TransactionScope();
+
+    private:
+        Context m_previousContext;
+        bool m_running;
+    };
+
+    static bool isRunning() { return s_running.load(std::memory_order_relaxed); }
+
+    // Samples every interval of CPU time, keeping as many samples as fit into bufferSize bytes.
+    static bool start(const std::string& tracePath, size_t bufferSize, std::chrono::microseconds interval);
+    // Stops sampling and writes the samples to the trace file, in collapsed stack format.
+    static void stop();
+
+    // Sets the context of the current thread, and returns the one it replaces.
+    static Context setContext(const Context&);
+
+    // Called by the platform from the signal handler on the sampled thread.
+    static void recordSample(void* const* frames, int32_t frameCount);
+
+    // Names the callable a callback runs: the function, or else the type of the lambda or functor, which tells where
+    // it was posted from. match is the key of the callback, which is the address of a function.
+    static std::string describeCallable(const std::type_info& callableType, intptr_t match);
+
+private:
+    struct Sample {
+        Context context;
+        int32_t frameCount;
+        void* frames[MAX_FRAMES];
+    };
+
+    typedef std::unordered_map<const void*, std::string> SymbolCache;
+
+    static bool writeTrace(const std::string& tracePath, const Sample* samples, size_t sampleCount, int64_t droppedCount);
+    static std::string describe(const Context&, SymbolCache&);
+    static const std::string& symbolize(const void* address, SymbolCache&);
+
+    static bool platformStartSampling(std::chrono::microseconds interval);
+    static void platformStopSampling();
+    // Returns the name of the function which contains the address, or else its module and offset.
+    static std::string platformSymbolize(const void* address);
+    static std::string platformDemangle(const char* name);
+
+    static std::atomic<bool> s_running;
+};
+
+} // namespace os
+} // namespace android
@@ -25,6 +25,7 @@
 
 #include "ServiceObject.h"
 
+#include "BinderProvider.h"
 #include "ParcelPrivate.h"
 #include "ServiceChannel.h"
 #include "ServiceObjectRef.h"
@@ -100,14 +101,14 @@ void ServiceObject::deref()
 
 void ServiceObject::createFromParcel(Parcel&)
 {
-    assert(ApplicationProcess::current().isRoot());
+    assert(BinderProvider::isRootProcess());
     m_objectUid = newObjectUid();
 }
 
 void ServiceObject::updateFromBundle(Bundle& data, int64_t senderPid)
 {
     LOGD("ServiceObject %d is being updated by request from process %lld", m_objectUid, senderPid);
-    assert(ApplicationProcess::current().isRoot());
+    assert(BinderProvider::isRootProcess());
 }
 
 void ServiceObject::readFromParcel(Parcel& source)
@@ -148,7 +149,7 @@ bool ServiceObject::update(Bundle& data)
 void ServiceObject::notify(int64_t senderPid)
 {
     LOGD("ServiceObject %d is broadcasting update notification triggered by process %lld", m_objectUid, senderPid);
-    assert(ApplicationProcess::current().isRoot());
+    assert(BinderProvider::isRootProcess());
 
     auto& clients = s_registry->at(m_objectUid).clients;
     for (auto client : clients) {
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Watchdog.h"
+
+#include <android/os/MessageQueue.h>
+#include <android/os/SystemClock.h>
+#include <android/util/Printer.h>
+#include <android++/LogHelper.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace android {
+namespace os {
+
+static void print(util::Printer* printer, const char* line)
+{
+    if (printer)
+        printer->println(line);
+    else
+        LOGE("%s", line);
+}
+
+Watchdog& Watchdog::shared()
+{
+    static NeverDestroyed<Watchdog> watchdog;
+    return watchdog;
+}
+
+void Watchdog::addQueue(const std::shared_ptr<MessageQueue>& queue)
+{
+    synchronized (this) {
+        m_queues.push_back(queue);
+        if (m_running)
+            queue->m_metrics->setWatched(true);
+    }
+}
+
+void Watchdog::removeQueue(MessageQueue* queue)
+{
+    synchronized (this) {
+        m_queues.erase(std::remove_if(m_queues.begin(), m_queues.end(), [queue] (const std::weak_ptr<MessageQueue>& entry) {
+            std::shared_ptr<MessageQueue> watchedQueue = entry.lock();
+            return !watchedQueue || watchedQueue.get() == queue;
+        }), m_queues.end());
+    }
+}
+
+void Watchdog::setStallThreshold(std::chrono::milliseconds threshold, util::Printer* printer)
+{
+    std::thread stoppedThread;
+    synchronized (this) {
+        m_threshold = threshold;
+        m_printer = printer;
+
+        bool running = threshold > std::chrono::milliseconds::zero();
+        if (running != m_running) {
+            m_running = running;
+            for (std::weak_ptr<MessageQueue>& entry : m_queues) {
+                if (std::shared_ptr<MessageQueue> queue = entry.lock())
+                    queue->m_metrics->setWatched(running);
+            }
+
+            if (running)
+                m_thread = std::thread([this] { run(); });
+            else
+                stoppedThread = std::move(m_thread);
+        }
+        notifyAll();
+    }
+
+    if (stoppedThread.joinable())
+        stoppedThread.join();
+}
+
+void Watchdog::run()
+{
+    // Stalls reported so far, by the generation of the dispatch which stalls, so that each is reported once.
+    std::unordered_map<const MessageQueue*, uint64_t> reportedStalls;
+
+    while (true) {
+        bool stopped = false;
+        std::chrono::nanoseconds threshold;
+        util::Printer* printer = nullptr;
+        std::vector<std::shared_ptr<MessageQueue>> queues;
+        synchronized (this) {
+            // Every looper is looked at twice per threshold, so a stall is reported before it lasts one and a half.
+            wait(m_threshold / 2);
+            // A watchdog which was stopped and started again runs on a new thread.
+            stopped = !m_running || m_thread.get_id() != std::this_thread::get_id();
+            threshold = m_threshold;
+            printer = m_printer;
+            for (std::weak_ptr<MessageQueue>& entry : m_queues) {
+                if (std::shared_ptr<MessageQueue> queue = entry.lock())
+                    queues.push_back(std::move(queue));
+            }
+        }
+
+        if (stopped)
+            break;
+
+        std::unordered_map<const MessageQueue*, uint64_t> stalls;
+        std::chrono::nanoseconds currentTime = SystemClock::steadyUptimeNanos();
+        for (std::shared_ptr<MessageQueue>& queue : queues) {
+            // The clock of a virtual time queue has nothing to do with how long its thread has been busy.
+            if (queue->usesVirtualTime())
+                continue;
+
+            LooperMetrics::DispatchRecord record;
+            uint64_t generation;
+            if (!queue->m_metrics->currentDispatch(record, generation))
+                continue;
+
+            std::chrono::nanoseconds stalledFor = currentTime - record.startTime;
+            if (stalledFor < threshold)
+                continue;
+
+            stalls[queue.get()] = generation;
+            auto reported = reportedStalls.find(queue.get());
+            if (reported == reportedStalls.end() || reported->second != generation)
+                report(*queue, record, generation, stalledFor, printer);
+        }
+        reportedStalls = std::move(stalls);
+    }
+}
+
+void Watchdog::report(MessageQueue& queue, const LooperMetrics::DispatchRecord& record, uint64_t generation,
+    std::chrono::nanoseconds stalledFor, util::Printer* printer)
+{
+    std::vector<std::string> frames;
+    bool captured = platformCaptureStack(queue.m_tid, frames);
+
+    char description[256];
+    char line[512];
+    LooperMetrics::describe(record, description, sizeof(description));
+    snprintf(line, sizeof(line), "Looper (tid=%lld) stalled for %lldms dispatching to %s", static_cast<long long>(queue.m_tid),
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(stalledFor).count()), description);
+    print(printer, line);
+
+    if (!captured) {
+        print(printer, "  (stack unavailable)");
+        return;
+    }
+
+    LooperMetrics::DispatchRecord currentRecord;
+    uint64_t currentGeneration;
+    if (!queue.m_metrics->currentDispatch(currentRecord, currentGeneration) || currentGeneration != generation)
+        print(printer, "  (the dispatch finished while the stack was being captured)");
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        snprintf(line, sizeof(line), "  #%02d %s", static_cast<int32_t>(i), frames[i].c_str());
+        print(printer, line);
+    }
+}
+
+} // namespace os
+} // namespace android
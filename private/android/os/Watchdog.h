@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <android/os/LooperMetrics.h>
+#include <android++/NeverDestroyed.h>
+#include <java/lang.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace android {
+namespace util {
+class Printer;
+}
+namespace os {
+
+class MessageQueue;
+
+// Checks every looper of the process from a thread of its own, and reports any which has been dispatching the same
+// message or callback for longer than a threshold, along with the stack of its thread.
+class Watchdog final : public Object {
+    NONCOPYABLE(Watchdog);
+public:
+    static Watchdog& shared();
+
+    void addQueue(const std::shared_ptr<MessageQueue>&);
+    void removeQueue(MessageQueue*);
+
+    // Zero stops the watchdog. Reports go to the printer, or to the error log if it is null.
+    void setStallThreshold(std::chrono::milliseconds, util::Printer*);
+
+private:
+    friend class WTF::NeverDestroyed<Watchdog>;
+
+    Watchdog() = default;
+
+    void run();
+    void report(MessageQueue&, const LooperMetrics::DispatchRecord&, uint64_t generation, std::chrono::nanoseconds stalledFor, util::Printer*);
+
+    // Fills in the frames of the given thread's stack, innermost first. Returns false if it couldn't be captured.
+    static bool platformCaptureStack(int64_t tid, std::vector<std::string>& frames);
+
+    std::vector<std::weak_ptr<MessageQueue>> m_queues;
+    std::chrono::nanoseconds m_threshold { 0 };
+    util::Printer* m_printer { nullptr };
+    std::thread m_thread;
+    bool m_running { false };
+};
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <android/os/Handler.h>
+#include <android/os/WorkItemAllocator.h>
+#include <java/lang.h>
+
+namespace android {
+namespace os {
+
+// Identifies a group of work items within one of the indexes of a queue.
+struct WorkItemKey {
+    const Handler* owner;
+    intptr_t value;
+    bool isMessage;
+
+    bool operator==(const WorkItemKey& other) const
+    {
+        return owner == other.owner && value == other.value && isMessage == other.isMessage;
+    }
+};
+
+// An entry of a MessageQueue. Subclasses decide what performing the work means, and describe themselves through
+// the keys under which the queue indexes them.
+class WorkItem {
+    NONCOPYABLE(WorkItem);
+    friend class MessageQueue;
+    friend class WorkItemChain;
+    friend class WorkQueue;
+public:
+    enum Index {
+        // Every item, by owner.
+        OWNER_INDEX,
+        // Messages by what, callbacks by the identity of the callable they run.
+        MATCH_INDEX,
+        // Items posted with a token, or messages carrying an obj, by that pointer.
+        TOKEN_INDEX,
+        INDEX_COUNT
+    };
+
+    WorkItem(Handler& owner, std::chrono::nanoseconds fireTime, bool isMessage, intptr_t match, const void* token, bool asynchronous, Handler::Priority priority)
+        : m_owner(owner)
+        , m_fireTime(fireTime)
+        , m_isMessage(isMessage)
+        , m_asynchronous(asynchronous)
+        , m_priority(static_cast<int8_t>(priority))
+        , m_match(match)
+        , m_token(token)
+    {
+    }
+    virtual ~WorkItem() = default;
+
+    // Work items live in the slab of the queue they are posted to.
+    static void* operator new(size_t size, WorkItemAllocator& allocator) { return allocator.allocate(size); }
+    static void operator delete(void* p, WorkItemAllocator&) { WorkItemAllocator::deallocate(p); }
+    static void operator delete(void* p) { WorkItemAllocator::deallocate(p); }
+
+    virtual void performWork() = 0;
+    // The type of the callable a callback runs, or null for messages.
+    virtual const std::type_info* callableType() const { return nullptr; }
+
+    Handler& owner() const { return m_owner; }
+    std::chrono::nanoseconds fireTime() const { return m_fireTime; }
+    int64_t sequence() const { return m_sequence; }
+    bool isMessage() const { return m_isMessage; }
+    // Asynchronous items are not held back by synchronization barriers.
+    bool isAsynchronous() const { return m_asynchronous; }
+    // The lane of the queue the item is kept in.
+    Handler::Priority priority() const { return static_cast<Handler::Priority>(m_priority); }
+    const void* token() const { return m_token; }
+
+    // Returns false if the item isn't part of the given index.
+    bool indexKey(Index index, WorkItemKey& key) const
+    {
+        switch (index) {
+        case OWNER_INDEX:
+            key = { &m_owner, 0, false };
+            return true;
+        case MATCH_INDEX:
+            key = { &m_owner, m_match, m_isMessage };
+            return true;
+        case TOKEN_INDEX:
+            key = { &m_owner, reinterpret_cast<intptr_t>(m_token), false };
+            return !!m_token;
+        default:
+            return false;
+        }
+    }
+
+protected:
+    Handler& m_owner;
+    // Uptime at which the work is due, in SystemClock::uptimeNanos() time base.
+    std::chrono::nanoseconds m_fireTime;
+    int64_t m_sequence { 0 };
+    bool m_isMessage;
+    bool m_asynchronous;
+    int8_t m_priority;
+    intptr_t m_match;
+    const void* m_token;
+
+private:
+    struct IndexLink {
+        WorkItem* previous { nullptr };
+        WorkItem* next { nullptr };
+    };
+
+    size_t m_heapIndex { 0 };
+    IndexLink m_links[INDEX_COUNT];
+    // Link of the lock-free list which holds items posted from other threads until the queue drains them.
+    WorkItem* m_nextIncoming { nullptr };
+};
+
+} // namespace os
+} // namespace android
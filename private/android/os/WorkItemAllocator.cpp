@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "WorkItemAllocator.h"
+
+#include <algorithm>
+#include <new>
+
+namespace android {
+namespace os {
+
+static const uint64_t tagIncrement = uint64_t(1) << 32;
+
+WorkItemAllocator::~WorkItemAllocator()
+{
+    uint32_t slabCount = std::min<uint32_t>(m_slabCount, MAX_SLABS);
+    for (uint32_t i = 0; i < slabCount; ++i)
+        delete[] m_slabs[i].load();
+}
+
+void* WorkItemAllocator::allocate(size_t size)
+{
+    Block* block = nullptr;
+    if (size <= MAX_OBJECT_SIZE) {
+        block = pop();
+        if (!block)
+            block = carveSlab();
+    }
+
+    if (!block)
+        block = new (::operator new(HEADER_SIZE + size)) Block(nullptr, 0);
+
+    return reinterpret_cast<unsigned char*>(block) + HEADER_SIZE;
+}
+
+void WorkItemAllocator::deallocate(void* object)
+{
+    if (!object)
+        return;
+
+    Block* block = reinterpret_cast<Block*>(static_cast<unsigned char*>(object) - HEADER_SIZE);
+    if (block->owner)
+        block->owner->push(block);
+    else
+        ::operator delete(block);
+}
+
+WorkItemAllocator::Block* WorkItemAllocator::blockAt(uint32_t index) const
+{
+    return reinterpret_cast<Block*>(m_slabs[index / BLOCKS_PER_SLAB].load(std::memory_order_acquire) + index % BLOCKS_PER_SLAB);
+}
+
+WorkItemAllocator::Block* WorkItemAllocator::pop()
+{
+    uint64_t head = m_freeList.load(std::memory_order_acquire);
+    while (uint32_t top = static_cast<uint32_t>(head)) {
+        Block* block = blockAt(top - 1);
+        uint64_t next = ((head & ~uint64_t(UINT32_MAX)) + tagIncrement) | block->next.load(std::memory_order_relaxed);
+        if (m_freeList.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+            return block;
+    }
+    return nullptr;
+}
+
+void WorkItemAllocator::push(Block* block)
+{
+    uint64_t head = m_freeList.load(std::memory_order_relaxed);
+    uint64_t top;
+    do {
+        block->next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        top = ((head & ~uint64_t(UINT32_MAX)) + tagIncrement) | (block->index + 1);
+    } while (!m_freeList.compare_exchange_weak(head, top, std::memory_order_release, std::memory_order_relaxed));
+}
+
+WorkItemAllocator::Block* WorkItemAllocator::carveSlab()
+{
+    static_assert(sizeof(Block) <= HEADER_SIZE, "The block header must fit before the object");
+
+    if (m_slabCount.load(std::memory_order_relaxed) >= MAX_SLABS)
+        return nullptr;
+
+    // Racing threads each carve a slab of their own, which only costs the memory of a slab.
+    uint32_t slabIndex = m_slabCount.fetch_add(1, std::memory_order_relaxed);
+    if (slabIndex >= MAX_SLABS)
+        return nullptr;
+
+    Slot* slab = new Slot[BLOCKS_PER_SLAB];
+    for (uint32_t i = 0; i < BLOCKS_PER_SLAB; ++i)
+        new (&slab[i]) Block(this, static_cast<uint32_t>(slabIndex * BLOCKS_PER_SLAB + i));
+    m_slabs[slabIndex].store(slab, std::memory_order_release);
+
+    // The first block is handed out, the others go onto the free list.
+    for (uint32_t i = 1; i < BLOCKS_PER_SLAB; ++i)
+        push(reinterpret_cast<Block*>(&slab[i]));
+    return reinterpret_cast<Block*>(&slab[0]);
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <java/lang.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+namespace android {
+namespace os {
+
+// Hands out fixed size blocks for the WorkItems of one MessageQueue. Blocks are carved from slabs and kept on a
+// free list once released, so posting doesn't go through the global allocator in the steady state. The free list is
+// a lock-free stack, as foreign threads allocate while the looper thread releases.
+class WorkItemAllocator final {
+    NONCOPYABLE(WorkItemAllocator);
+public:
+    static const size_t BLOCK_SIZE = 256;
+    static const size_t BLOCKS_PER_SLAB = 64;
+    // Once this many slabs have been carved, further blocks come from the heap.
+    static const size_t MAX_SLABS = 1024;
+    // Blocks start with a header which records where they came from, padded to keep the objects after it aligned.
+    static const size_t HEADER_SIZE = (sizeof(void*) + sizeof(uint64_t) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    // The largest object that fits into a block.
+    static const size_t MAX_OBJECT_SIZE = BLOCK_SIZE - HEADER_SIZE;
+
+    WorkItemAllocator() = default;
+    ~WorkItemAllocator();
+
+    // Objects which don't fit into a block are allocated from the heap.
+    void* allocate(size_t);
+    static void deallocate(void*);
+
+private:
+    struct Block {
+        Block(WorkItemAllocator* owner, uint32_t index) : owner(owner), index(index), next(0) { }
+
+        WorkItemAllocator* owner;
+        uint32_t index;
+        // Index plus one of the block below this one while it is on the free list. It is atomic because a stale
+        // pop may read it while the block is handed out again.
+        std::atomic<uint32_t> next;
+    };
+
+    struct alignas(std::max_align_t) Slot {
+        unsigned char bytes[BLOCK_SIZE];
+    };
+
+    Block* blockAt(uint32_t index) const;
+    Block* pop();
+    void push(Block*);
+    Block* carveSlab();
+
+    // Index plus one of the top block in the low half, and a count of the changes made in the high half, which
+    // tells a compare-and-swap apart from one made before the top block was popped and pushed again.
+    std::atomic<uint64_t> m_freeList { 0 };
+    std::atomic<uint32_t> m_slabCount { 0 };
+    std::atomic<Slot*> m_slabs[MAX_SLABS] { };
+};
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "WorkQueue.h"
+
+namespace android {
+namespace os {
+
+static bool firesBefore(const WorkItem& lhs, const WorkItem& rhs)
+{
+    if (lhs.fireTime() != rhs.fireTime())
+        return lhs.fireTime() < rhs.fireTime();
+    return lhs.sequence() < rhs.sequence();
+}
+
+WorkItemChain::~WorkItemChain()
+{
+    while (m_head) {
+        WorkItem* next = m_head->m_links[WorkItem::OWNER_INDEX].next;
+        delete m_head;
+        m_head = next;
+    }
+}
+
+void WorkItemChain::push(std::unique_ptr<WorkItem>&& item)
+{
+    // The item is no longer part of any index, so its owner link is free to chain it.
+    item->m_links[WorkItem::OWNER_INDEX].next = m_head;
+    m_head = item.release();
+}
+
+void WorkQueue::push(std::unique_ptr<WorkItem>&& item)
+{
+    link(*item);
+    item->m_heapIndex = m_heap.size();
+    m_heap.push_back(std::move(item));
+    siftUp(m_heap.size() - 1);
+}
+
+std::unique_ptr<WorkItem> WorkQueue::pop()
+{
+    return take(0);
+}
+
+bool WorkQueue::contains(WorkItem::Index index, const WorkItemKey& key, const std::function<bool (WorkItem&)>& filter) const
+{
+    auto head = m_indexes[index].find(key);
+    if (head == m_indexes[index].end())
+        return false;
+
+    if (!filter)
+        return true;
+
+    for (WorkItem* item = head->second; item; item = item->m_links[index].next) {
+        if (filter(*item))
+            return true;
+    }
+
+    return false;
+}
+
+void WorkQueue::remove(WorkItem::Index index, const WorkItemKey& key, const std::function<bool (WorkItem&)>& filter, WorkItemChain& removedItems)
+{
+    auto head = m_indexes[index].find(key);
+    if (head == m_indexes[index].end())
+        return;
+
+    WorkItem* item = head->second;
+    while (item) {
+        WorkItem* next = item->m_links[index].next;
+        if (!filter || filter(*item))
+            removedItems.push(take(item->m_heapIndex));
+        item = next;
+    }
+}
+
+void WorkQueue::removeAll(const std::function<bool (WorkItem&)>& filter, WorkItemChain& removedItems)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < m_heap.size(); ++i) {
+        if (filter(*m_heap[i])) {
+            unlink(*m_heap[i]);
+            removedItems.push(std::move(m_heap[i]));
+            continue;
+        }
+
+        m_heap[kept] = std::move(m_heap[i]);
+        m_heap[kept]->m_heapIndex = kept;
+        ++kept;
+    }
+
+    m_heap.resize(kept);
+    for (size_t i = kept / 2; i-- > 0;)
+        siftDown(i);
+}
+
+std::unique_ptr<WorkItem> WorkQueue::take(size_t heapIndex)
+{
+    std::unique_ptr<WorkItem> item = std::move(m_heap[heapIndex]);
+    std::unique_ptr<WorkItem> last = std::move(m_heap.back());
+    m_heap.pop_back();
+
+    if (heapIndex < m_heap.size()) {
+        last->m_heapIndex = heapIndex;
+        m_heap[heapIndex] = std::move(last);
+        siftDown(siftUp(heapIndex));
+    }
+
+    unlink(*item);
+    return item;
+}
+
+void WorkQueue::link(WorkItem& item)
+{
+    for (int32_t index = 0; index < WorkItem::INDEX_COUNT; ++index) {
+        WorkItemKey key;
+        if (!item.indexKey(static_cast<WorkItem::Index>(index), key))
+            continue;
+
+        WorkItem*& head = m_indexes[index][key];
+        item.m_links[index].previous = nullptr;
+        item.m_links[index].next = head;
+        if (head)
+            head->m_links[index].previous = &item;
+        head = &item;
+    }
+}
+
+void WorkQueue::unlink(WorkItem& item)
+{
+    for (int32_t index = 0; index < WorkItem::INDEX_COUNT; ++index) {
+        WorkItemKey key;
+        if (!item.indexKey(static_cast<WorkItem::Index>(index), key))
+            continue;
+
+        WorkItem::IndexLink& link = item.m_links[index];
+        if (link.previous)
+            link.previous->m_links[index].next = link.next;
+        else if (link.next)
+            m_indexes[index][key] = link.next;
+        else
+            m_indexes[index].erase(key);
+
+        if (link.next)
+            link.next->m_links[index].previous = link.previous;
+
+        link = WorkItem::IndexLink();
+    }
+}
+
+void WorkQueue::swap(size_t a, size_t b)
+{
+    std::swap(m_heap[a], m_heap[b]);
+    m_heap[a]->m_heapIndex = a;
+    m_heap[b]->m_heapIndex = b;
+}
+
+size_t WorkQueue::siftUp(size_t heapIndex)
+{
+    while (heapIndex > 0) {
+        size_t parent = (heapIndex - 1) / 2;
+        if (!firesBefore(*m_heap[heapIndex], *m_heap[parent]))
+            break;
+        swap(heapIndex, parent);
+        heapIndex = parent;
+    }
+
+    return heapIndex;
+}
+
+void WorkQueue::siftDown(size_t heapIndex)
+{
+    while (true) {
+        size_t first = heapIndex;
+        size_t left = heapIndex * 2 + 1;
+        size_t right = left + 1;
+        if (left < m_heap.size() && firesBefore(*m_heap[left], *m_heap[first]))
+            first = left;
+        if (right < m_heap.size() && firesBefore(*m_heap[right], *m_heap[first]))
+            first = right;
+        if (first == heapIndex)
+            return;
+        swap(heapIndex, first);
+        heapIndex = first;
+    }
+}
+
+} // namespace os
+} // namespace android
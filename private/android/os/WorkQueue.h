@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <android/os/WorkItem.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace android {
+namespace os {
+
+// Work items taken out of a WorkQueue. They are destroyed together with the chain, which callers arrange to
+// happen after the queue lock has been released.
+class WorkItemChain final {
+    NONCOPYABLE(WorkItemChain);
+public:
+    WorkItemChain() = default;
+    ~WorkItemChain();
+
+    bool empty() const { return !m_head; }
+    void push(std::unique_ptr<WorkItem>&&);
+
+private:
+    WorkItem* m_head { nullptr };
+};
+
+// The pending work of a MessageQueue. Items are kept in a binary min-heap on (fireTime, sequence), so the next
+// one to fire is always on top and items sharing a fire time fire in the order they were enqueued. Each item is
+// also linked into intrusive per-key lists, so lookups and removals by owner, what, callback or token only
+// visit the items under that key.
+class WorkQueue final {
+    NONCOPYABLE(WorkQueue);
+public:
+    WorkQueue() = default;
+    ~WorkQueue() = default;
+
+    bool empty() const { return m_heap.empty(); }
+    size_t size() const { return m_heap.size(); }
+    // Returns the item which fires first.
+    WorkItem& top() const { return *m_heap[0]; }
+
+    void push(std::unique_ptr<WorkItem>&&);
+    std::unique_ptr<WorkItem> pop();
+
+    // Returns true if an item with the given key matches filter, or simply exists if there's no filter.
+    bool contains(WorkItem::Index, const WorkItemKey&, const std::function<bool (WorkItem&)>& filter) const;
+    // Moves the items with the given key which match filter, or all of them if there's no filter, to removedItems.
+    void remove(WorkItem::Index, const WorkItemKey&, const std::function<bool (WorkItem&)>& filter, WorkItemChain& removedItems);
+    // Moves every item matching filter to removedItems. This visits the whole queue.
+    void removeAll(const std::function<bool (WorkItem&)>& filter, WorkItemChain& removedItems);
+
+private:
+    struct WorkItemKeyHash {
+        size_t operator()(const WorkItemKey& key) const
+        {
+            return std::hash<const void*>()(key.owner) ^ (std::hash<intptr_t>()(key.value) * 31 + key.isMessage);
+        }
+    };
+
+    std::unique_ptr<WorkItem> take(size_t heapIndex);
+    void link(WorkItem&);
+    void unlink(WorkItem&);
+    void swap(size_t, size_t);
+    size_t siftUp(size_t heapIndex);
+    void siftDown(size_t heapIndex);
+
+    std::vector<std::unique_ptr<WorkItem>> m_heap;
+    std::unordered_map<WorkItemKey, WorkItem*, WorkItemKeyHash> m_indexes[WorkItem::INDEX_COUNT];
+};
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BinderProviderLinux.h"
+
+#include <android/os/Messenger.h>
+#include <android/os/ParcelPrivate.h>
+#include <android/os/SystemClock.h>
+#include <android++/LogHelper.h>
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace android {
+namespace os {
+
+static std::mutex& providersLock()
+{
+    static std::mutex lock;
+    return lock;
+}
+
+static std::unordered_map<intptr_t, BinderProviderLinux*>& providers()
+{
+    static std::unordered_map<intptr_t, BinderProviderLinux*> providers;
+    return providers;
+}
+
+std::unique_ptr<BinderProvider> BinderProvider::create(Client& client)
+{
+    return std::make_unique<BinderProviderLinux>(client);
+}
+
+class SenderClient final : public Binder::Client {
+public:
+    void onCreate() override { }
+    void onDestroy() override { }
+    void onTimer() override { }
+    void onTransaction(int32_t, Parcel&, Parcel*, int32_t) override { }
+};
+
+std::shared_ptr<Binder> BinderProvider::sender()
+{
+    // There is no application process to send from, so each thread gets a binder of its own, which also receives the
+    // replies to its transactions.
+    static SenderClient client;
+    static thread_local std::shared_ptr<Binder> sender = Binder::create(client);
+    return sender;
+}
+
+bool BinderProvider::isRootProcess()
+{
+    // Without an application process there are no other processes, so this one owns every service object.
+    return true;
+}
+
+BinderProviderLinux::BinderProviderLinux(Client& client)
+    : BinderProvider(client)
+    , m_eventLoop(EventLoopLinux::current())
+    , m_eventFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    , m_timerFd(::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC))
+{
+    m_eventLoop->addFd(m_eventFd, EPOLLIN, [this] (uint32_t) { eventFired(); });
+    m_eventLoop->addFd(m_timerFd, EPOLLIN, [this] (uint32_t) { timerFired(); });
+
+    {
+        std::lock_guard<std::mutex> lock(providersLock());
+        providers()[handle()] = this;
+    }
+
+    m_client.onCreate();
+}
+
+BinderProviderLinux::~BinderProviderLinux()
+{
+    close();
+}
+
+std::shared_ptr<EventLoopLinux> BinderProviderLinux::eventLoopOf(intptr_t handle)
+{
+    std::lock_guard<std::mutex> lock(providersLock());
+    auto provider = providers().find(handle);
+    if (provider == providers().end())
+        return nullptr;
+
+    return provider->second->m_eventLoop;
+}
+
+void BinderProviderLinux::deliver(EventLoopLinux::Transaction& transaction)
+{
+    BinderProviderLinux* binder;
+    {
+        std::lock_guard<std::mutex> lock(providersLock());
+        auto provider = providers().find(transaction.destination);
+        if (provider == providers().end())
+            return;
+        binder = provider->second;
+    }
+
+    Parcel data;
+    // The sender is blocked until the transaction has been delivered, so its data is read in place.
+    std::shared_ptr<ParcelPrivate> dataPrivate = ParcelPrivate::initializeBorrowed(data, transaction.data.data(), transaction.data.dataSize());
+    binder->m_client.onTransaction(transaction.code, data, transaction.replyTo, transaction.flags);
+    ParcelPrivate::endBorrowing(data, dataPrivate);
+    transaction.delivered = true;
+}
+
+void BinderProviderLinux::eventFired()
+{
+    eventfd_t value;
+    ::eventfd_read(m_eventFd, &value);
+    m_pendingTimers = 0;
+    m_client.onTimer();
+}
+
+void BinderProviderLinux::timerFired()
+{
+    uint64_t expirations;
+    if (::read(m_timerFd, &expirations, sizeof(expirations)) != sizeof(expirations))
+        return;
+    m_client.onTimer();
+}
+
+intptr_t BinderProviderLinux::handle() const
+{
+    return reinterpret_cast<intptr_t>(this);
+}
+
+bool BinderProviderLinux::start()
+{
+    if (m_pendingTimers.fetch_add(1) == 0)
+        return ::eventfd_write(m_eventFd, 1) == 0;
+    return true;
+}
+
+bool BinderProviderLinux::startAtTime(std::chrono::nanoseconds uptimeNanos)
+{
+    if (uptimeNanos <= SystemClock::steadyUptimeNanos())
+        return start();
+
+    // steady_clock is CLOCK_MONOTONIC, so the deadline can be handed to the timer as is.
+    std::chrono::nanoseconds deadline = uptimeNanos;
+
+    itimerspec timer = {};
+    timer.it_value.tv_sec = std::chrono::duration_cast<std::chrono::seconds>(deadline).count();
+    timer.it_value.tv_nsec = (deadline % std::chrono::seconds(1)).count();
+    if (::timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &timer, nullptr) < 0) {
+        LOGE("Couldn't arm the timer, errno = %d", errno);
+        return false;
+    }
+    return true;
+}
+
+void BinderProviderLinux::stop()
+{
+    itimerspec timer = {};
+    ::timerfd_settime(m_timerFd, 0, &timer, nullptr);
+}
+
+void BinderProviderLinux::close()
+{
+    if (m_closed)
+        return;
+
+    m_closed = true;
+    m_client.onDestroy();
+
+    {
+        std::lock_guard<std::mutex> lock(providersLock());
+        providers().erase(handle());
+    }
+
+    m_eventLoop->removeFd(m_eventFd);
+    m_eventLoop->removeFd(m_timerFd);
+    ::close(m_eventFd);
+    ::close(m_timerFd);
+}
+
+bool BinderProviderLinux::transact(Binder* destination, int32_t code, Parcel& data, int32_t flags)
+{
+    if (m_closed) {
+        LOGE("%s", "Wrong source");
+        return false;
+    }
+
+    std::shared_ptr<EventLoopLinux> destinationLoop = eventLoopOf(destination->handle());
+    if (!destinationLoop) {
+        LOGE("%s", "Wrong destination");
+        return false;
+    }
+
+    intptr_t replyTo = flags == IBinder::FLAG_ONEWAY ? 0 : handle();
+    EventLoopLinux::Transaction transaction { destination->handle(), code, data, replyTo, replyTo ? 0 : IBinder::FLAG_ONEWAY,
+        EventLoopLinux::current(), false, false };
+
+    // Like SendMessage, a transaction to a binder of the calling thread is delivered directly.
+    if (destinationLoop == transaction.sender)
+        deliver(transaction);
+    else
+        destinationLoop->transact(transaction);
+
+    if (!transaction.delivered) {
+        LOGE("%s", "Transaction failed");
+        return false;
+    }
+    return true;
+}
+
+} // namespace os
+} // namespace android
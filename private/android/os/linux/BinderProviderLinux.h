@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <android/os/BinderProvider.h>
+
+#include "EventLoopLinux.h"
+
+namespace android {
+namespace os {
+
+class BinderProviderLinux final : public BinderProvider {
+    friend class EventLoopLinux;
+public:
+    BinderProviderLinux(Client&);
+    virtual ~BinderProviderLinux();
+
+    intptr_t handle() const override;
+
+    bool start() override;
+    bool startAtTime(std::chrono::nanoseconds) override;
+    void stop() override;
+
+    void close() override;
+
+    bool transact(Binder* destination, int32_t code, Parcel& data, int32_t flags) override;
+
+private:
+    static std::shared_ptr<EventLoopLinux> eventLoopOf(intptr_t handle);
+    static void deliver(EventLoopLinux::Transaction&);
+
+    void eventFired();
+    void timerFired();
+
+    std::shared_ptr<EventLoopLinux> m_eventLoop;
+    int32_t m_eventFd;
+    int32_t m_timerFd;
+    std::atomic<int32_t> m_pendingTimers { 0 };
+    bool m_closed { false };
+};
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "EventLoopLinux.h"
+
+#include "BinderProviderLinux.h"
+#include <android++/LogHelper.h>
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace android {
+namespace os {
+
+static const int32_t maxEventsPerWait = 16;
+
+static std::mutex& eventLoopsLock()
+{
+    static std::mutex lock;
+    return lock;
+}
+
+static std::unordered_map<int64_t, std::weak_ptr<EventLoopLinux>>& eventLoops()
+{
+    static std::unordered_map<int64_t, std::weak_ptr<EventLoopLinux>> loops;
+    return loops;
+}
+
+static thread_local std::shared_ptr<EventLoopLinux> threadEventLoop;
+
+std::shared_ptr<EventLoopLinux> EventLoopLinux::current()
+{
+    if (!threadEventLoop) {
+        threadEventLoop = std::shared_ptr<EventLoopLinux>(new EventLoopLinux(::syscall(SYS_gettid)));
+        std::lock_guard<std::mutex> lock(eventLoopsLock());
+        eventLoops()[threadEventLoop->m_tid] = threadEventLoop;
+    }
+
+    return threadEventLoop;
+}
+
+std::shared_ptr<EventLoopLinux> EventLoopLinux::forThread(int64_t tid)
+{
+    std::lock_guard<std::mutex> lock(eventLoopsLock());
+    auto loop = eventLoops().find(tid);
+    if (loop == eventLoops().end())
+        return nullptr;
+
+    return loop->second.lock();
+}
+
+EventLoopLinux::EventLoopLinux(int64_t tid)
+    : m_tid(tid)
+    , m_epollFd(::epoll_create1(EPOLL_CLOEXEC))
+    , m_wakeFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = m_wakeFd;
+    if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event) < 0)
+        LOGE("Couldn't watch the wake event of thread %lld, errno = %d", m_tid, errno);
+}
+
+EventLoopLinux::~EventLoopLinux()
+{
+    {
+        std::lock_guard<std::mutex> lock(eventLoopsLock());
+        auto loop = eventLoops().find(m_tid);
+        if (loop != eventLoops().end() && loop->second.expired())
+            eventLoops().erase(loop);
+    }
+
+    ::close(m_wakeFd);
+    ::close(m_epollFd);
+}
+
+bool EventLoopLinux::addFd(int32_t fd, uint32_t events, Callback&& callback)
+{
+    epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    int32_t operation = m_callbacks.count(fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (::epoll_ctl(m_epollFd, operation, fd, &event) < 0) {
+        LOGE("Couldn't watch file descriptor %d, errno = %d", fd, errno);
+        return false;
+    }
+
+    m_callbacks[fd] = std::make_shared<Callback>(std::move(callback));
+    return true;
+}
+
+void EventLoopLinux::removeFd(int32_t fd)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (!m_callbacks.erase(fd))
+        return;
+
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+int32_t EventLoopLinux::run()
+{
+    epoll_event events[maxEventsPerWait];
+
+    while (!m_quitting) {
+        int32_t count = ::epoll_wait(m_epollFd, events, maxEventsPerWait, -1);
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            LOGE("Waiting for events failed, errno = %d", errno);
+            break;
+        }
+
+        for (int32_t i = 0; i < count && !m_quitting; ++i) {
+            if (events[i].data.fd == m_wakeFd) {
+                awoken();
+                continue;
+            }
+
+            // A callback may remove a file descriptor whose event is still pending in this batch.
+            std::shared_ptr<Callback> callback;
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                auto watched = m_callbacks.find(events[i].data.fd);
+                if (watched != m_callbacks.end())
+                    callback = watched->second;
+            }
+
+            if (callback)
+                (*callback)(events[i].events);
+        }
+    }
+
+    m_quitting = false;
+    return m_exitCode;
+}
+
+void EventLoopLinux::quit(int32_t exitCode)
+{
+    m_exitCode = exitCode;
+    m_quitting = true;
+    wake();
+}
+
+void EventLoopLinux::transact(Transaction& transaction)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_transactions.push_back(&transaction);
+    }
+    m_transactionCondition.notify_all();
+    wake();
+
+    EventLoopLinux& sender = *transaction.sender;
+    std::unique_lock<std::mutex> lock(sender.m_lock);
+    while (!transaction.completed) {
+        if (sender.m_transactions.empty()) {
+            sender.m_transactionCondition.wait(lock);
+            continue;
+        }
+
+        lock.unlock();
+        sender.performTransactions();
+        lock.lock();
+    }
+}
+
+void EventLoopLinux::wake()
+{
+    if (::eventfd_write(m_wakeFd, 1) < 0)
+        LOGE("Couldn't wake thread %lld, errno = %d", m_tid, errno);
+}
+
+void EventLoopLinux::awoken()
+{
+    eventfd_t value;
+    ::eventfd_read(m_wakeFd, &value);
+
+    performTransactions();
+}
+
+void EventLoopLinux::performTransactions()
+{
+    while (true) {
+        Transaction* transaction;
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (m_transactions.empty())
+                return;
+            transaction = m_transactions.front();
+            m_transactions.pop_front();
+        }
+
+        BinderProviderLinux::deliver(*transaction);
+        complete(*transaction);
+    }
+}
+
+void EventLoopLinux::complete(Transaction& transaction)
+{
+    EventLoopLinux& sender = *transaction.sender;
+    {
+        std::lock_guard<std::mutex> lock(sender.m_lock);
+        transaction.completed = true;
+    }
+    sender.m_transactionCondition.notify_all();
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <android/os/Parcel.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace android {
+namespace os {
+
+// The epoll set of a looper thread. Watched file descriptors are dispatched on the owning thread, and a single
+// eventfd is used to wake it up from other threads, either to quit or to deliver binder transactions.
+class EventLoopLinux final {
+    NONCOPYABLE(EventLoopLinux);
+public:
+    typedef std::function<void (uint32_t events)> Callback;
+
+    struct Transaction {
+        intptr_t destination;
+        int32_t code;
+        Parcel& data;
+        intptr_t replyTo;
+        int32_t flags;
+        std::shared_ptr<EventLoopLinux> sender;
+        bool delivered;
+        bool completed;
+    };
+
+    // Returns the event loop of the calling thread, creating it if necessary.
+    static std::shared_ptr<EventLoopLinux> current();
+    // Returns the event loop of the given thread, or null if it doesn't have one.
+    static std::shared_ptr<EventLoopLinux> forThread(int64_t tid);
+
+    ~EventLoopLinux();
+
+    int64_t tid() const { return m_tid; }
+
+    // Starts watching fd for the given epoll events, or updates the events of an already watched fd.
+    bool addFd(int32_t fd, uint32_t events, Callback&&);
+    void removeFd(int32_t fd);
+
+    // Dispatches events until quit() is called.
+    int32_t run();
+    void quit(int32_t exitCode);
+
+    // Hands a transaction over to this loop and blocks until it has been delivered. Transactions sent to the
+    // calling thread meanwhile are still delivered, so a synchronous reply can't deadlock.
+    void transact(Transaction&);
+
+private:
+    EventLoopLinux(int64_t tid);
+
+    void wake();
+    void awoken();
+    void performTransactions();
+    void complete(Transaction&);
+
+    int64_t m_tid;
+    int32_t m_epollFd;
+    int32_t m_wakeFd;
+    std::atomic<bool> m_quitting { false };
+    int32_t m_exitCode { 0 };
+    std::mutex m_lock;
+    std::condition_variable m_transactionCondition;
+    std::unordered_map<int32_t, std::shared_ptr<Callback>> m_callbacks;
+    std::deque<Transaction*> m_transactions;
+};
+
+} // namespace os
+} // namespace android
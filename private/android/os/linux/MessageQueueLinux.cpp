@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/os/MessageQueue.h>
+
+#include "EventLoopLinux.h"
+
+#include <sys/epoll.h>
+
+namespace android {
+namespace os {
+
+typedef MessageQueue::OnFileDescriptorEventListener Listener;
+
+static uint32_t toEpollEvents(int32_t events)
+{
+    uint32_t epollEvents = 0;
+    if (events & Listener::EVENT_INPUT)
+        epollEvents |= EPOLLIN;
+    if (events & Listener::EVENT_OUTPUT)
+        epollEvents |= EPOLLOUT;
+    return epollEvents;
+}
+
+static int32_t fromEpollEvents(uint32_t epollEvents)
+{
+    int32_t events = 0;
+    if (epollEvents & EPOLLIN)
+        events |= Listener::EVENT_INPUT;
+    if (epollEvents & EPOLLOUT)
+        events |= Listener::EVENT_OUTPUT;
+    if (epollEvents & (EPOLLERR | EPOLLHUP))
+        events |= Listener::EVENT_ERROR;
+    return events;
+}
+
+bool MessageQueue::platformWatchFileDescriptor(int32_t fd, int32_t events)
+{
+    std::shared_ptr<EventLoopLinux> eventLoop = EventLoopLinux::forThread(m_tid);
+    if (!eventLoop)
+        return false;
+
+    return eventLoop->addFd(fd, toEpollEvents(events), [this, fd] (uint32_t epollEvents) {
+        dispatchFileDescriptorEvents(fd, fromEpollEvents(epollEvents));
+    });
+}
+
+void MessageQueue::platformUnwatchFileDescriptor(int32_t fd)
+{
+    if (std::shared_ptr<EventLoopLinux> eventLoop = EventLoopLinux::forThread(m_tid))
+        eventLoop->removeFd(fd);
+}
+
+} // namespace os
+} // namespace android
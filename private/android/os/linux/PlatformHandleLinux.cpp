@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "PlatformHandle.h"
+
+#include <android++/LogHelper.h>
+
+#include <unistd.h>
+
+namespace android {
+namespace os {
+
+// Handles are file descriptors. Binder transactions don't leave the process on Linux, so handles are never moved
+// across processes.
+
+void PlatformHandle::platformClose(intptr_t handle)
+{
+    if (handle)
+        ::close(static_cast<int>(handle));
+}
+
+intptr_t PlatformHandle::platformDuplicate(intptr_t handle)
+{
+    if (!handle)
+        return 0;
+
+    int duplicatedHandle = ::dup(static_cast<int>(handle));
+    return duplicatedHandle < 0 ? 0 : duplicatedHandle;
+}
+
+intptr_t PlatformHandle::platformDuplicate(intptr_t handle, int64_t sourcePid)
+{
+    if (!sourcePid || !handle)
+        return 0;
+
+    if (sourcePid != ::getpid()) {
+        LOGE("Handles can't be received from process %lld", static_cast<long long>(sourcePid));
+        return 0;
+    }
+
+    // The sender duplicated the handle for us, like DuplicateHandle() with DUPLICATE_CLOSE_SOURCE does on Windows.
+    return handle;
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/os/SamplingProfiler.h>
+#include <android++/LogHelper.h>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <mutex>
+
+namespace android {
+namespace os {
+
+// The frames of the signal handler and of the signal trampoline, which aren't part of a sample.
+static const int32_t handlerFrameCount = 2;
+
+static timer_t samplingTimer;
+
+static void takeSample(int)
+{
+    int savedErrno = errno;
+    void* frames[SamplingProfiler::MAX_FRAMES + handlerFrameCount];
+    int32_t frameCount = ::backtrace(frames, SamplingProfiler::MAX_FRAMES + handlerFrameCount);
+    if (frameCount > handlerFrameCount)
+        SamplingProfiler::recordSample(frames + handlerFrameCount, frameCount - handlerFrameCount);
+    errno = savedErrno;
+}
+
+static bool installSampleHandler()
+{
+    // The first backtrace() loads the unwinder, which allocates, so it mustn't happen in the signal handler.
+    void* frame;
+    ::backtrace(&frame, 1);
+
+    // The handler stays installed once sampling stopped, since the default action of a late SIGPROF is to terminate.
+    struct sigaction action = {};
+    action.sa_handler = takeSample;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (::sigaction(SIGPROF, &action, nullptr)) {
+        LOGE("Couldn't install the sampling handler, errno = %d", errno);
+        return false;
+    }
+    return true;
+}
+
+bool SamplingProfiler::platformStartSampling(std::chrono::microseconds interval)
+{
+    static std::once_flag installed;
+    static bool handlerInstalled = false;
+    std::call_once(installed, [] { handlerInstalled = installSampleHandler(); });
+    if (!handlerInstalled)
+        return false;
+
+    // The timer runs on the CPU time of the whole process. Recent kernels signal the thread which used it up.
+    struct sigevent event = {};
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = SIGPROF;
+    if (::timer_create(CLOCK_PROCESS_CPUTIME_ID, &event, &samplingTimer)) {
+        LOGE("Couldn't create the sampling timer, errno = %d", errno);
+        return false;
+    }
+
+    std::chrono::nanoseconds intervalNanos = interval;
+    struct itimerspec timerSpec = {};
+    timerSpec.it_interval.tv_sec = static_cast<time_t>(intervalNanos.count() / 1000000000);
+    timerSpec.it_interval.tv_nsec = static_cast<long>(intervalNanos.count() % 1000000000);
+    timerSpec.it_value = timerSpec.it_interval;
+    if (::timer_settime(samplingTimer, 0, &timerSpec, nullptr)) {
+        LOGE("Couldn't start the sampling timer, errno = %d", errno);
+        ::timer_delete(samplingTimer);
+        return false;
+    }
+    return true;
+}
+
+void SamplingProfiler::platformStopSampling()
+{
+    ::timer_delete(samplingTimer);
+}
+
+std::string SamplingProfiler::platformSymbolize(const void* address)
+{
+    Dl_info info;
+    if (!::dladdr(address, &info) || !info.dli_fname) {
+        char unknown[32];
+        snprintf(unknown, sizeof(unknown), "%p", address);
+        return unknown;
+    }
+
+    if (info.dli_sname)
+        return platformDemangle(info.dli_sname);
+
+    // Functions which aren't exported are told apart by their module and offset.
+    const char* moduleName = strrchr(info.dli_fname, '/');
+    char symbol[512];
+    snprintf(symbol, sizeof(symbol), "%s+0x%llx", moduleName ? moduleName + 1 : info.dli_fname,
+        static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+    return symbol;
+}
+
+std::string SamplingProfiler::platformDemangle(const char* name)
+{
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (!demangled)
+        return name;
+
+    std::string result(demangled);
+    ::free(demangled);
+    return result;
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/os/Watchdog.h>
+#include <android++/LogHelper.h>
+
+#include <errno.h>
+#include <execinfo.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace android {
+namespace os {
+
+// The stuck thread is asked to unwind its own stack. SIGURG is ignored by default, so a signal which arrives late
+// or at a thread of another library is harmless. Signals which weren't sent by a capture are passed on to the handler
+// installed before ours. A library which replaces our handler later disables stack capture.
+static const int32_t captureSignal = SIGURG;
+static const int32_t maxFrames = 64;
+static const std::chrono::milliseconds captureTimeout = std::chrono::milliseconds(500);
+
+// Each capture has a buffer of its own, so a handler which runs after its capture timed out can't write over the
+// frames of a later one.
+struct CaptureRequest {
+    pid_t tid;
+    void* frames[maxFrames];
+    int32_t frameCount { 0 };
+    sem_t captured;
+    // Set by the handler once it no longer touches the request.
+    std::atomic<bool> finished { false };
+};
+
+static struct sigaction previousAction;
+// The capture waiting for its handler to run. The handler claims it by swapping it out.
+static std::atomic<CaptureRequest*> pendingRequest { nullptr };
+// Requests which timed out after their handler claimed them, deleted once the handler has finished. Only the
+// watchdog thread captures stacks, one at a time.
+static std::vector<CaptureRequest*> abandonedRequests;
+
+static void forwardToPreviousHandler(int signal, siginfo_t* info, void* context)
+{
+    if (previousAction.sa_flags & SA_SIGINFO) {
+        if (previousAction.sa_sigaction)
+            previousAction.sa_sigaction(signal, info, context);
+    } else if (previousAction.sa_handler != SIG_DFL && previousAction.sa_handler != SIG_IGN) {
+        previousAction.sa_handler(signal);
+    }
+}
+
+static void captureStack(int signal, siginfo_t* info, void* context)
+{
+    if (info->si_code != SI_TKILL || info->si_pid != ::getpid()) {
+        forwardToPreviousHandler(signal, info, context);
+        return;
+    }
+
+    int savedErrno = errno;
+    CaptureRequest* request = pendingRequest.load();
+    if (request && request->tid == static_cast<pid_t>(::syscall(SYS_gettid)) && pendingRequest.compare_exchange_strong(request, nullptr)) {
+        request->frameCount = ::backtrace(request->frames, maxFrames);
+        ::sem_post(&request->captured);
+        request->finished.store(true);
+    }
+    errno = savedErrno;
+}
+
+static void installCaptureHandler()
+{
+    // The first backtrace() loads the unwinder, which allocates, so it mustn't happen in the signal handler.
+    void* frame;
+    ::backtrace(&frame, 1);
+
+    struct sigaction action = {};
+    action.sa_sigaction = captureStack;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(captureSignal, &action, &previousAction);
+}
+
+static void deleteRequest(CaptureRequest* request)
+{
+    ::sem_destroy(&request->captured);
+    delete request;
+}
+
+bool Watchdog::platformCaptureStack(int64_t tid, std::vector<std::string>& frames)
+{
+    static std::once_flag installed;
+    std::call_once(installed, installCaptureHandler);
+
+    abandonedRequests.erase(std::remove_if(abandonedRequests.begin(), abandonedRequests.end(), [] (CaptureRequest* request) {
+        if (!request->finished.load())
+            return false;
+        deleteRequest(request);
+        return true;
+    }), abandonedRequests.end());
+
+    CaptureRequest* request = new CaptureRequest;
+    request->tid = static_cast<pid_t>(tid);
+    ::sem_init(&request->captured, 0, 0);
+    pendingRequest.store(request);
+
+    if (::syscall(SYS_tgkill, ::getpid(), static_cast<pid_t>(tid), captureSignal)) {
+        LOGW("Could not signal thread %lld, errno = %d", static_cast<long long>(tid), errno);
+        pendingRequest.store(nullptr);
+        deleteRequest(request);
+        return false;
+    }
+
+    struct timespec deadline;
+    ::clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += std::chrono::nanoseconds(captureTimeout).count();
+    deadline.tv_sec += deadline.tv_nsec / 1000000000;
+    deadline.tv_nsec %= 1000000000;
+    while (::sem_timedwait(&request->captured, &deadline)) {
+        if (errno == EINTR)
+            continue;
+
+        // If the handler claimed the request meanwhile, it may still be writing to it.
+        CaptureRequest* pending = request;
+        if (pendingRequest.compare_exchange_strong(pending, nullptr))
+            deleteRequest(request);
+        else
+            abandonedRequests.push_back(request);
+        return false;
+    }
+
+    // The innermost frame is the signal handler.
+    char** symbols = ::backtrace_symbols(request->frames, request->frameCount);
+    bool symbolized = symbols;
+    for (int32_t i = 1; symbolized && i < request->frameCount; ++i)
+        frames.push_back(symbols[i]);
+    ::free(symbols);
+
+    // The handler sets finished right after posting, but may not have yet.
+    if (request->finished.load())
+        deleteRequest(request);
+    else
+        abandonedRequests.push_back(request);
+    return symbolized;
+}
+
+} // namespace os
+} // namespace android
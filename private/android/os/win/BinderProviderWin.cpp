@@ -25,8 +25,10 @@
 
 #include "BinderProviderWin.h"
 
+#include <android/app/ApplicationProcess.h>
 #include <android/os/Messenger.h>
 #include <android/os/ParcelPrivate.h>
+#include <android/os/SystemClock.h>
 #include <android++/LogHelper.h>
 
 #include <mmsystem.h>
@@ -68,6 +70,16 @@ std::unique_ptr<BinderProvider> BinderProvider::create(Client& client)
     return std::make_unique<BinderProviderWin>(client);
 }
 
+std::shared_ptr<Binder> BinderProvider::sender()
+{
+    return ApplicationProcess::current().self();
+}
+
+bool BinderProvider::isRootProcess()
+{
+    return ApplicationProcess::current().isRoot();
+}
+
 BinderProviderWin::BinderProviderWin(Client& client)
     : BinderProvider(client)
     , m_activeTimerID(0)
@@ -136,8 +148,10 @@ LRESULT BinderProviderWin::messageWindowProcInternal(HWND hWnd, UINT message, WP
         intptr_t replyTo = wParam;
         COPYDATASTRUCT* copyData = (COPYDATASTRUCT*)lParam;
         Parcel data;
-        ParcelPrivate::initializeWithCopy(data, reinterpret_cast<int8_t*>(copyData->lpData), copyData->cbData);
+        // The data stays valid while the message is being handled, so it is read in place.
+        std::shared_ptr<ParcelPrivate> dataPrivate = ParcelPrivate::initializeBorrowed(data, reinterpret_cast<int8_t*>(copyData->lpData), copyData->cbData);
         binder->m_client.onTransaction(copyData->dwData, data, replyTo, replyTo ? 0 : IBinder::FLAG_ONEWAY);
+        ParcelPrivate::endBorrowing(data, dataPrivate);
         return TRUE;
     }
     case WM_TIMER:
@@ -182,9 +196,11 @@ bool BinderProviderWin::start()
     return true;
 }
 
-bool BinderProviderWin::startAtTime(std::chrono::milliseconds uptimeMillis)
+bool BinderProviderWin::startAtTime(std::chrono::nanoseconds uptimeNanos)
 {
-    std::chrono::milliseconds delayMillis = uptimeMillis - System::currentTimeMillis();
+    // Windows timers have millisecond granularity, so round up rather than waking before the deadline.
+    std::chrono::nanoseconds delay = uptimeNanos - SystemClock::steadyUptimeNanos();
+    std::chrono::milliseconds delayMillis = std::chrono::duration_cast<std::chrono::milliseconds>(delay + std::chrono::milliseconds(1) - std::chrono::nanoseconds(1));
 
     DWORD dueTime;
     if (delayMillis.count() > USER_TIMER_MAXIMUM)
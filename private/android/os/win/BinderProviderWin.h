@@ -40,7 +40,7 @@ public:
     intptr_t handle() const override;
 
     bool start() override;
-    bool startAtTime(std::chrono::milliseconds) override;
+    bool startAtTime(std::chrono::nanoseconds) override;
     void stop() override;
 
     void close() override;
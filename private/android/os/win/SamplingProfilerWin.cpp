@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/os/SamplingProfiler.h>
+#include <android++/LogHelper.h>
+
+#include "SymbolizerWin.h"
+
+#include <windows.h>
+
+namespace android {
+namespace os {
+
+bool SamplingProfiler::platformStartSampling(std::chrono::microseconds)
+{
+    // There are no signals to interrupt the running thread with, so sampling would have to suspend threads from
+    // a thread of its own, which isn't done yet.
+    LOGW("%s", "Sampling isn't supported on this platform");
+    return false;
+}
+
+void SamplingProfiler::platformStopSampling()
+{
+}
+
+std::string SamplingProfiler::platformSymbolize(const void* address)
+{
+    return symbolizeAddress(address);
+}
+
+std::string SamplingProfiler::platformDemangle(const char* name)
+{
+    // Type names are demangled already.
+    return name;
+}
+
+} // namespace os
+} // namespace android
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/os/Watchdog.h>
+#include <android++/LogHelper.h>
+
+#include "SymbolizerWin.h"
+
+#include <windows.h>
+
+namespace android {
+namespace os {
+
+static const int32_t maxFrames = 64;
+
+#if defined(_M_X64)
+// Walks the stack of a suspended thread. Nothing in here may allocate, since the thread may hold the heap lock.
+static int32_t unwindStack(HANDLE thread, DWORD64* frames)
+{
+    CONTEXT context = {};
+    context.ContextFlags = CONTEXT_FULL;
+    if (!::GetThreadContext(thread, &context))
+        return 0;
+
+    int32_t frameCount = 0;
+    while (context.Rip && frameCount < maxFrames) {
+        frames[frameCount++] = context.Rip;
+
+        DWORD64 imageBase;
+        PRUNTIME_FUNCTION function = ::RtlLookupFunctionEntry(context.Rip, &imageBase, nullptr);
+        if (!function) {
+            // Leaf functions have no unwind data, and their return address is at the top of the stack.
+            context.Rip = *reinterpret_cast<DWORD64*>(context.Rsp);
+            context.Rsp += sizeof(DWORD64);
+            continue;
+        }
+
+        PVOID handlerData;
+        DWORD64 establisherFrame;
+        ::RtlVirtualUnwind(UNW_FLAG_NHANDLER, imageBase, context.Rip, function, &context, &handlerData, &establisherFrame, nullptr);
+    }
+    return frameCount;
+}
+#endif
+
+bool Watchdog::platformCaptureStack(int64_t tid, std::vector<std::string>& frames)
+{
+#if defined(_M_X64)
+    HANDLE thread = ::OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION, FALSE, static_cast<DWORD>(tid));
+    if (!thread) {
+        LOGW("Could not open thread %lld, error = %lu", static_cast<long long>(tid), ::GetLastError());
+        return false;
+    }
+
+    DWORD64 addresses[maxFrames];
+    int32_t frameCount = 0;
+    if (::SuspendThread(thread) != static_cast<DWORD>(-1)) {
+        frameCount = unwindStack(thread, addresses);
+        ::ResumeThread(thread);
+    }
+    ::CloseHandle(thread);
+
+    for (int32_t i = 0; i < frameCount; ++i)
+        frames.push_back(symbolizeAddress(reinterpret_cast<const void*>(addresses[i])));
+    return frameCount > 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace os
+} // namespace android
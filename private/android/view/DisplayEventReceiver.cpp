@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DisplayEventReceiver.h"
+
+#include <android/os/Handler.h>
+#include <android/os/SystemClock.h>
+
+namespace android {
+namespace view {
+
+static const int32_t defaultRefreshRate = 60;
+
+DisplayEventReceiver::DisplayEventReceiver(os::Looper* looper, OnVsync&& onVsync)
+    : m_handler(std::make_unique<os::Handler>(looper, true, os::Handler::PRIORITY_ANIMATION))
+    , m_onVsync(std::move(onVsync))
+    , m_vsyncInterval(std::chrono::nanoseconds(std::chrono::seconds(1)) / defaultRefreshRate)
+{
+}
+
+DisplayEventReceiver::~DisplayEventReceiver()
+{
+}
+
+void DisplayEventReceiver::scheduleVsync()
+{
+    std::chrono::nanoseconds now = SystemClock::uptimeNanos();
+    std::chrono::nanoseconds vsyncTime = (now / m_vsyncInterval + 1) * m_vsyncInterval;
+    m_handler->postAtTime([this, vsyncTime] {
+        m_onVsync(vsyncTime);
+    }, vsyncTime);
+}
+
+} // namespace view
+} // namespace android
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2016 NAVER Corp. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <java/lang.h>
+
+namespace android {
+namespace os {
+class Handler;
+class Looper;
+}
+namespace view {
+
+// Delivers vsync pulses to a looper. This is a software vsync: pulses are timed by the looper itself, on
+// multiples of the frame interval in the SystemClock::uptimeNanos() time base, so every receiver of a process
+// shares the same phase.
+class DisplayEventReceiver final {
+    NONCOPYABLE(DisplayEventReceiver);
+public:
+    typedef std::function<void (std::chrono::nanoseconds frameTimeNanos)> OnVsync;
+
+    DisplayEventReceiver(os::Looper*, OnVsync&&);
+    ~DisplayEventReceiver();
+
+    std::chrono::nanoseconds vsyncInterval() const { return m_vsyncInterval; }
+
+    // Schedules a single vsync pulse to be delivered when the next display frame begins.
+    void scheduleVsync();
+
+private:
+    std::unique_ptr<os::Handler> m_handler;
+    OnVsync m_onVsync;
+    std::chrono::nanoseconds m_vsyncInterval;
+};
+
+} // namespace view
+} // namespace android
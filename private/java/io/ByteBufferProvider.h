@@ -35,6 +35,10 @@ public:
     virtual ~ByteBufferProvider() = default;
 
     virtual size_t size() const = 0;
+    virtual size_t capacity() const = 0;
+    // Makes room for at least the given number of bytes, keeping the data.
+    virtual void reserve(size_t) = 0;
+    // Changes the size within the capacity. Bytes added are left uninitialized.
     virtual void resize(size_t) = 0;
     virtual int8_t* data() = 0;
 };
@@ -25,6 +25,9 @@
 
 #include "ByteReader.h"
 
+#include <stdint.h>
+#include <string.h>
+
 namespace java {
 namespace io {
 
@@ -42,6 +45,16 @@ void ByteReader::reset()
     m_pointer = m_buffer->data();
 }
 
+size_t ByteReader::position() const
+{
+    return m_pointer - m_buffer->data();
+}
+
+void ByteReader::seek(size_t offset)
+{
+    m_pointer = m_buffer->data() + offset;
+}
+
 void ByteReader::read(void* out, size_t length, size_t alignment)
 {
     if (!move(length, alignment))
@@ -53,19 +66,24 @@ void ByteReader::read(void* out, size_t length, size_t alignment)
 
 int8_t* ByteReader::readArray(size_t& length, size_t alignment)
 {
+    length = 0;
     read(&length, sizeof(length), sizeof(length));
-    if (!move(length * alignment, alignment))
+    // A corrupt length must not wrap around the size check below.
+    if (length > SIZE_MAX / alignment || !move(length * alignment, alignment)) {
+        length = 0;
         return nullptr;
+    }
 
     int8_t* arrayPosition = m_pointer;
     m_pointer += length * alignment;
     return arrayPosition;
 }
 
-static inline int8_t* alignPointer(int8_t* ptr, size_t alignment)
+// Aligns like ByteWriter does, relative to the start of the buffer, which Parcel keeps aligned for any type.
+static inline int8_t* alignPointer(int8_t* ptr, int8_t* start, size_t alignment)
 {
-    uintptr_t alignmentMask = alignment - 1;
-    return reinterpret_cast<int8_t*>((reinterpret_cast<intptr_t>(ptr) + alignmentMask) & ~alignmentMask);
+    size_t offset = ptr - start;
+    return start + ((offset + alignment - 1) / alignment) * alignment;
 }
 
 static inline bool isAvailable(const int8_t* alignedPosition, const int8_t* bufferEnd, size_t size)
@@ -75,8 +93,9 @@ static inline bool isAvailable(const int8_t* alignedPosition, const int8_t* buff
 
 int8_t* ByteReader::move(size_t length, size_t alignment)
 {
-    int8_t* alignedPosition = alignPointer(m_pointer, alignment);
-    if (!isAvailable(alignedPosition, m_buffer->data() + m_buffer->size(), length)) {
+    int8_t* start = m_buffer->data();
+    int8_t* alignedPosition = alignPointer(m_pointer, start, alignment);
+    if (!isAvailable(alignedPosition, start + m_buffer->size(), length)) {
         return nullptr;
     }
     
@@ -36,8 +36,12 @@ public:
     virtual ~ByteReader();
 
     void reset();
+    // Offset of the next read from the start of the buffer.
+    size_t position() const;
+    void seek(size_t offset);
 
     void read(void* out, size_t length, size_t alignment);
+    // Returns the elements of an array in place, or nullptr and a length of zero if they don't fit the buffer.
     int8_t* readArray(size_t& length, size_t alignment);
 
 private:
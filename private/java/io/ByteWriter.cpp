@@ -25,6 +25,9 @@
 
 #include "ByteWriter.h"
 
+#include <algorithm>
+#include <string.h>
+
 namespace java {
 namespace io {
 
@@ -45,7 +48,8 @@ void ByteWriter::reset()
 void ByteWriter::write(const void* in, size_t length, size_t alignment)
 {
     int8_t* buffer = grow(length, alignment);
-    memcpy(buffer, in, length);
+    if (length)
+        memcpy(buffer, in, length);
 }
 
 void ByteWriter::writeArray(const void* in, size_t length, size_t alignment)
@@ -54,6 +58,8 @@ void ByteWriter::writeArray(const void* in, size_t length, size_t alignment)
     write(in, length * alignment, alignment);
 }
 
+static const size_t minimumCapacity = 256;
+
 static inline size_t alignLength(size_t length, size_t alignment)
 {
     return ((length + alignment - 1) / alignment) * alignment;
@@ -61,9 +67,18 @@ static inline size_t alignLength(size_t length, size_t alignment)
 
 int8_t* ByteWriter::grow(size_t length, size_t alignment)
 {
-    size_t alignedSize = alignLength(m_buffer->size(), alignment);
-    m_buffer->resize(alignedSize + length);
-    return m_buffer->data() + alignedSize;
+    size_t size = m_buffer->size();
+    size_t alignedSize = alignLength(size, alignment);
+    size_t newSize = alignedSize + length;
+    // The capacity grows geometrically, so writing n bytes reallocates O(log n) times.
+    if (newSize > m_buffer->capacity())
+        m_buffer->reserve(std::max(newSize, std::max(m_buffer->capacity() * 2, minimumCapacity)));
+    m_buffer->resize(newSize);
+
+    // Padding is cleared, so that no stale memory ends up in the data.
+    int8_t* data = m_buffer->data();
+    memset(data + size, 0, alignedSize - size);
+    return data + alignedSize;
 }
 
 } // namespace io
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2017 Daewoong Jang.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/media/MediaPlayer.h>
+#include <android/media/mock/MediaPlayerPrivateMock.h>
+#include <android/os/Looper.h>
+#include <android/os/SystemClock.h>
+
+#include <algorithm>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Plays a clip through MediaPlayerPrivateMock on a virtual clock, and checks that its callbacks are dispatched in
+// order and at the times the mock schedules them. The whole clip takes no time in reality.
+
+using namespace std::chrono_literals;
+
+using Mock = android::media::MediaPlayerPrivateMock;
+
+struct Event {
+    std::string name;
+    int64_t timeMillis;
+};
+
+static const int32_t seekPosition = 10000;
+
+static std::vector<Event> expectedEvents()
+{
+    std::vector<Event> events;
+    // The prepared listener starts playback and seeks, then the mock reports the first buffering update and the
+    // video size at the same time.
+    events.push_back({ "prepared", Mock::mediaPrepareLatency });
+    events.push_back({ "buffering " + std::to_string(Mock::mediaInitialBuffering), Mock::mediaPrepareLatency });
+    events.push_back({ "videoSize", Mock::mediaPrepareLatency });
+    events.push_back({ "seekComplete", Mock::mediaPrepareLatency + Mock::mediaSeekingLatency });
+
+    int64_t time = Mock::mediaPrepareLatency;
+    for (int32_t percent = Mock::mediaInitialBuffering; percent < 100; ) {
+        percent = std::min(percent + Mock::mediaBufferingIncrement, 100);
+        time += Mock::mediaBufferingLatency;
+        events.push_back({ "buffering " + std::to_string(percent), time });
+    }
+
+    // Playback advances a frame at a time from the start, and from seekPosition once the seek completes, until it
+    // passes the duration.
+    const int32_t frame = Mock::mediaFrameAvailableLatency;
+    int32_t framesBeforeSeek = Mock::mediaSeekingLatency / frame;
+    int32_t framesAfterSeek = (Mock::mediaDuration - seekPosition) / frame + 1;
+    events.push_back({ "completion", Mock::mediaPrepareLatency + int64_t(framesBeforeSeek + framesAfterSeek) * frame });
+    return events;
+}
+
+int main(int argc, char* argv[])
+{
+    Looper::prepareVirtualTime();
+    Looper* looper = Looper::myLooper();
+    std::chrono::milliseconds start = SystemClock::uptimeMillis();
+
+    std::vector<Event> events;
+    auto record = [&](std::string name) {
+        events.push_back({ std::move(name), (SystemClock::uptimeMillis() - start).count() });
+    };
+
+    bool completed = false;
+    {
+        MediaPlayer player;
+        player.setOnPreparedListener([&] {
+            record("prepared");
+            player.start();
+            player.seekTo(seekPosition);
+        });
+        player.setOnBufferingUpdateListener([&](int32_t percent) { record("buffering " + std::to_string(percent)); });
+        player.setOnVideoSizeChangedListener([&](int32_t, int32_t) { record("videoSize"); });
+        player.setOnSeekCompleteListener([&] { record("seekComplete"); });
+        player.setOnCompletionListener([&] {
+            record("completion");
+            completed = true;
+        });
+
+        player.setDataSource(L"mock://clip");
+        player.prepareAsync();
+
+        for (int32_t second = 0; second < 60 && !completed; ++second)
+            looper->advanceBy(1s);
+        // The mock waits for its pending callbacks when it is destroyed, so they have to run first.
+        looper->runUntilIdle();
+    }
+
+    std::vector<Event> expected = expectedEvents();
+    bool passed = true;
+    for (size_t i = 0; i < std::max(events.size(), expected.size()); ++i) {
+        std::string actual = (i < events.size()) ? events[i].name + " at " + std::to_string(events[i].timeMillis) : "-";
+        std::string wanted = (i < expected.size()) ? expected[i].name + " at " + std::to_string(expected[i].timeMillis) : "-";
+        bool matches = actual == wanted;
+        passed &= matches;
+        if (matches)
+            printf("  %s\n", actual.c_str());
+        else
+            printf("! %s, expected %s\n", actual.c_str(), wanted.c_str());
+    }
+
+    printf("%s\n", passed ? "PASS" : "FAIL");
+    return passed ? 0 : 1;
+}